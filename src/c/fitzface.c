@@ -1,84 +1,76 @@
 #include <pebble.h>
 
-// Message Keys (auto-generated IDs will be used from package.json)
-#define KEY_TEMPERATURE MESSAGE_KEY_TEMPERATURE
-#define KEY_WIND_SPEED MESSAGE_KEY_WIND_SPEED
-#define KEY_UV_INDEX MESSAGE_KEY_UV_INDEX
-#define KEY_WEATHER_CODE MESSAGE_KEY_WEATHER_CODE
-#define KEY_WEATHER_CODE_TOMORROW MESSAGE_KEY_WEATHER_CODE_TOMORROW
-#define KEY_TEMP_MAX MESSAGE_KEY_TEMP_MAX
-#define KEY_TEMP_MIN MESSAGE_KEY_TEMP_MIN
-#define KEY_SUNRISE MESSAGE_KEY_SUNRISE
-#define KEY_SUNSET MESSAGE_KEY_SUNSET
-#define KEY_WIND_MAX MESSAGE_KEY_WIND_MAX
-#define KEY_AQI MESSAGE_KEY_AQI
-#define KEY_PRECIPITATION_PROBABILITY MESSAGE_KEY_PRECIPITATION_PROBABILITY
-#define KEY_TIDE_NEXT_TIME MESSAGE_KEY_TIDE_NEXT_TIME
-#define KEY_TIDE_NEXT_TYPE MESSAGE_KEY_TIDE_NEXT_TYPE
-#define KEY_TIDE_NEXT_HEIGHT MESSAGE_KEY_TIDE_NEXT_HEIGHT
-#define KEY_LOCATION_NAME MESSAGE_KEY_LOCATION_NAME
-#define KEY_LAST_UPDATE MESSAGE_KEY_LAST_UPDATE
-#define KEY_ALERT_TEXT MESSAGE_KEY_ALERT_TEXT
-#define KEY_ALERT_ACTIVE MESSAGE_KEY_ALERT_ACTIVE
-
-// Config Keys
-#define KEY_CONFIG_TEMP_UNIT MESSAGE_KEY_CONFIG_TEMP_UNIT
-#define KEY_CONFIG_WIND_UNIT MESSAGE_KEY_CONFIG_WIND_UNIT
-#define KEY_CONFIG_SHOW_AQI MESSAGE_KEY_CONFIG_SHOW_AQI
-#define KEY_CONFIG_SHOW_UV MESSAGE_KEY_CONFIG_SHOW_UV
-#define KEY_CONFIG_SHOW_WIND MESSAGE_KEY_CONFIG_SHOW_WIND
-#define KEY_CONFIG_SHOW_TIDE MESSAGE_KEY_CONFIG_SHOW_TIDE
-#define KEY_CONFIG_SHOW_SUNRISE MESSAGE_KEY_CONFIG_SHOW_SUNRISE
-#define KEY_CONFIG_INVERT MESSAGE_KEY_CONFIG_INVERT
-
-// MUNI Keys (timestamps)
-#define KEY_MUNI_TIMESTAMP_1 MESSAGE_KEY_MUNI_TIMESTAMP_1
-#define KEY_MUNI_TIMESTAMP_2 MESSAGE_KEY_MUNI_TIMESTAMP_2
-#define KEY_MUNI_TIMESTAMP_3 MESSAGE_KEY_MUNI_TIMESTAMP_3
-#define KEY_MUNI_TIMESTAMP_4 MESSAGE_KEY_MUNI_TIMESTAMP_4
-#define KEY_MUNI_TIMESTAMP_5 MESSAGE_KEY_MUNI_TIMESTAMP_5
-#define KEY_MUNI_TIMESTAMP_6 MESSAGE_KEY_MUNI_TIMESTAMP_6
-
-// Pollen Keys
-#define KEY_POLLEN_TREE MESSAGE_KEY_POLLEN_TREE
-#define KEY_POLLEN_GRASS MESSAGE_KEY_POLLEN_GRASS
-#define KEY_POLLEN_WEED MESSAGE_KEY_POLLEN_WEED
-
-// Persistence Keys
-#define PERSIST_KEY_TEMPERATURE 1
-#define PERSIST_KEY_WIND_SPEED 2
-#define PERSIST_KEY_UV_INDEX 3
-#define PERSIST_KEY_WEATHER_CODE 4
-#define PERSIST_KEY_WEATHER_CODE_TOMORROW 13
-#define PERSIST_KEY_AQI 5
-#define PERSIST_KEY_TEMP_MAX 6
-#define PERSIST_KEY_TEMP_MIN 7
-#define PERSIST_KEY_TIDE_TIME 8
-#define PERSIST_KEY_TIDE_TYPE 9
-#define PERSIST_KEY_SUNRISE 10
-#define PERSIST_KEY_SUNSET 11
-#define PERSIST_KEY_LOCATION 12
-#define PERSIST_KEY_ALERT_TEXT 14
-#define PERSIST_KEY_ALERT_ACTIVE 15
-#define PERSIST_KEY_MUNI_TIMESTAMP_1 16
-#define PERSIST_KEY_MUNI_TIMESTAMP_2 17
-#define PERSIST_KEY_MUNI_TIMESTAMP_3 21
-#define PERSIST_KEY_MUNI_TIMESTAMP_4 22
-#define PERSIST_KEY_MUNI_TIMESTAMP_5 23
-#define PERSIST_KEY_MUNI_TIMESTAMP_6 24
-#define PERSIST_KEY_POLLEN_TREE 18
-#define PERSIST_KEY_POLLEN_GRASS 19
-#define PERSIST_KEY_POLLEN_WEED 20
-#define PERSIST_KEY_PRECIPITATION_PROBABILITY 25
-
-// Configuration persistence
-#define PERSIST_KEY_CONFIG_TEMP_UNIT 50
-#define PERSIST_KEY_CONFIG_SHOW_AQI 51
-#define PERSIST_KEY_CONFIG_SHOW_UV 52
-#define PERSIST_KEY_CONFIG_SHOW_WIND 53
-#define PERSIST_KEY_CONFIG_SHOW_TIDE 54
-#define PERSIST_KEY_CONFIG_SHOW_SUNRISE 55
-#define PERSIST_KEY_CONFIG_INVERT 56
+// Compile-time features - set per platform by PLATFORM_EXCLUDED_FEATURES and
+// FITZFACE_EXCLUDE in wscript.
+// Builds without the wscript defines (e.g. CloudPebble) get every feature.
+#ifndef FEATURE_MUNI
+#define FEATURE_MUNI 1
+#endif
+#ifndef FEATURE_POLLEN
+#define FEATURE_POLLEN 1
+#endif
+#ifndef FEATURE_TIDE
+#define FEATURE_TIDE 1
+#endif
+#ifndef FEATURE_AQI
+#define FEATURE_AQI 1
+#endif
+#ifndef FEATURE_ALERTS
+#define FEATURE_ALERTS 1
+#endif
+#ifndef FEATURE_INVERT
+#define FEATURE_INVERT 1
+#endif
+
+// Log levels - LOG_* calls above FITZFACE_LOG_LEVEL are compiled out (set by
+// FITZFACE_LOG_LEVEL in wscript; release builds keep warnings and errors)
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARNING 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+#ifndef FITZFACE_LOG_LEVEL
+#define FITZFACE_LOG_LEVEL LOG_LEVEL_WARNING
+#endif
+
+#define LOG_AT(level, app_level, ...) \
+  do { if (FITZFACE_LOG_LEVEL >= (level)) { APP_LOG(app_level, __VA_ARGS__); } } while (0)
+#define LOG_ERROR(...) LOG_AT(LOG_LEVEL_ERROR, APP_LOG_LEVEL_ERROR, __VA_ARGS__)
+#define LOG_WARNING(...) LOG_AT(LOG_LEVEL_WARNING, APP_LOG_LEVEL_WARNING, __VA_ARGS__)
+#define LOG_INFO(...) LOG_AT(LOG_LEVEL_INFO, APP_LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_DEBUG(...) LOG_AT(LOG_LEVEL_DEBUG, APP_LOG_LEVEL_DEBUG, __VA_ARGS__)
+
+#ifdef FITZFACE_BENCHMARK
+// Timeline benchmark counters (tools/benchmark/timeline.py), logged as one
+// "BENCH" line per hour of watch time and reset
+typedef struct {
+  uint16_t messages_in;
+  uint16_t messages_out;
+  uint32_t bytes_in;
+  uint32_t bytes_out;
+  uint16_t persist_writes;
+  uint16_t redraws;
+  uint32_t heap_used_max;
+} BenchmarkCounters;
+
+static BenchmarkCounters s_bench;
+#define BENCH_COUNT(counter, n) (s_bench.counter += (n))
+
+// Count flash writes at every call site
+#define persist_write_int(key, value) (BENCH_COUNT(persist_writes, 1), persist_write_int(key, value))
+#define persist_write_bool(key, value) (BENCH_COUNT(persist_writes, 1), persist_write_bool(key, value))
+#define persist_write_string(key, value) (BENCH_COUNT(persist_writes, 1), persist_write_string(key, value))
+#define persist_write_data(key, data, size) (BENCH_COUNT(persist_writes, 1), persist_write_data(key, data, size))
+#else
+#define BENCH_COUNT(counter, n)
+#endif
+
+// Features reported to the phone with each refresh request (must match WATCH_FEATURE in index.js)
+#define WATCH_FEATURES ((FEATURE_MUNI << 0) | (FEATURE_POLLEN << 1) | (FEATURE_TIDE << 2) | \
+                        (FEATURE_AQI << 3) | (FEATURE_ALERTS << 4) | (FEATURE_INVERT << 5))
+
+// Message keys, their WeatherData/Config fields and persist slots are declared
+// once in package.json ("messageKeys" and "fitzface.messageSchema"); wscript
+// generates the decode table (message_schema.auto.h, included below).
 
 // UI Elements
 static Window *s_main_window;
@@ -88,9 +80,12 @@ static Layer *s_divider_layer;
 static TextLayer *s_time_layer;
 static TextLayer *s_date_layer;
 
+#if FEATURE_ALERTS
 // Alert section
 static TextLayer *s_alert_layer;
 static bool s_alert_active;
+#endif
+static int s_shown_nowcast = -1;  // nowcast_display_state() last seen by the tick or a sync
 
 // Header section
 static TextLayer *s_location_layer;
@@ -102,7 +97,9 @@ static GBitmap *s_weather_icon_tomorrow;
 // Data fields
 static TextLayer *s_wind_layer;
 static TextLayer *s_uv_layer;
+#if FEATURE_AQI
 static TextLayer *s_aqi_layer;
+#endif
 static TextLayer *s_temp_min_layer;
 static TextLayer *s_temp_current_layer;
 static TextLayer *s_temp_max_layer;
@@ -111,80 +108,403 @@ static BitmapLayer *s_temp_arrow_high_layer;
 static GBitmap *s_temp_arrow_low_bitmap;
 static GBitmap *s_temp_arrow_high_bitmap;
 
+#if FEATURE_MUNI
 // MUNI bus tracking (top-left grid cell)
 static TextLayer *s_muni_layer;
+#endif
 
+#if FEATURE_POLLEN
 // Pollen display (top right of header)
 static TextLayer *s_pollen_layer;
+#endif
 
 // Precipitation probability (top left of header)
 static TextLayer *s_precip_layer;
 
 // Footer
-static TextLayer *s_tide_layer;
 static TextLayer *s_sunrise_layer;
 static TextLayer *s_sunset_layer;
 static BitmapLayer *s_arrow_up_layer;
 static BitmapLayer *s_arrow_down_layer;
-static BitmapLayer *s_wave_layer;
 static GBitmap *s_arrow_up_bitmap;
 static GBitmap *s_arrow_down_bitmap;
+#if FEATURE_TIDE
+static TextLayer *s_tide_layer;
+static BitmapLayer *s_wave_layer;
 static GBitmap *s_wave_bitmap;
+#endif
+
+// Detail page - shown on a wrist tap; its layer and text exist only while visible
+#define DETAIL_PAGE_TIMEOUT_MS 8000
+#define DETAIL_TEXT_SIZE 288
+static TextLayer *s_detail_layer;
+static char *s_detail_text;
+static AppTimer *s_detail_timer;
+
+// Grid columns per row - a row loses its cell when that feature is compiled out
+#define GRID_TEMP_COLUMNS (FEATURE_MUNI ? 3 : 2)  // [MUNI] | Current | Lo|Hi
+#define GRID_DATA_COLUMNS (FEATURE_AQI ? 3 : 2)   // Wind | UV | [AQI]
+#define GRID_TIME_COLUMNS (FEATURE_TIDE ? 3 : 2)  // [Tide] | Sunrise | Sunset
+
+// Data groups - each is fetched from one provider and ages independently
+typedef enum {
+  DATA_GROUP_WEATHER = 0,  // Temperatures, wind, UV, precip, icons, alerts
+  DATA_GROUP_AQI,
+  DATA_GROUP_TIDE,
+  DATA_GROUP_MUNI,
+  DATA_GROUP_POLLEN,
+  DATA_GROUP_LOCATION,
+  DATA_GROUP_DAILY,        // Multi-day forecast (shifted locally at midnight)
+  DATA_GROUP_COUNT
+} DataGroup;
+
+// Freshness levels used by the renderer
+typedef enum {
+  FRESHNESS_FRESH = 0,
+  FRESHNESS_STALE,    // Shown with a '~' marker
+  FRESHNESS_EXPIRED   // Hidden
+} Freshness;
+
+// Freshness budgets per group, in minutes (0 = never)
+typedef struct {
+  uint16_t refresh_minutes;  // Request new data once older than this
+  uint16_t stale_minutes;    // Mark values as stale once older than this
+  uint16_t expire_minutes;   // Hide values once older than this
+} FreshnessBudget;
+
+static const FreshnessBudget s_freshness_budgets[DATA_GROUP_COUNT] = {
+  [DATA_GROUP_WEATHER]  = { 30,  90,   360 },
+  [DATA_GROUP_AQI]      = { 60,  180,  720 },
+  [DATA_GROUP_TIDE]     = { 360, 1440, 4320 },
+  [DATA_GROUP_MUNI]     = { 30,  45,   90 },
+  [DATA_GROUP_POLLEN]   = { 1440, 2880, 5760 },
+  [DATA_GROUP_LOCATION] = { 60,  360,  0 },
+  [DATA_GROUP_DAILY]    = { 1440, 2880, 0 },
+};
+
+// Minimum spacing between refresh requests while data stays stale
+#define REFRESH_RETRY_MINUTES 15
+
+// Power profiles - picked every minute from the battery, HealthService sleep
+// state and the configured quiet hours (must match POWER_PROFILE in index.js)
+typedef enum {
+  POWER_PROFILE_NORMAL = 0,
+  POWER_PROFILE_QUIET,        // Inside the configured quiet hours
+  POWER_PROFILE_LOW_BATTERY,  // At or below LOW_BATTERY_PERCENT and not charging
+  POWER_PROFILE_SLEEP,        // Wearer asleep (HealthService platforms only)
+  POWER_PROFILE_COUNT
+} PowerProfile;
+
+typedef struct {
+  uint16_t sync_minutes;  // Minimum spacing between refresh requests
+  uint8_t groups;         // Bit per DataGroup whose staleness may trigger a sync (0 = no syncs)
+  bool vibrate;           // Vibrate for new alerts
+} PowerProfileSettings;
+
+#define LOW_BATTERY_PERCENT 20
+#define GROUP_BIT(group) (1 << (group))
+#define ALL_GROUPS ((1 << DATA_GROUP_COUNT) - 1)
+#define ESSENTIAL_GROUPS (ALL_GROUPS & ~(GROUP_BIT(DATA_GROUP_MUNI) | GROUP_BIT(DATA_GROUP_POLLEN)))
+
+static const PowerProfileSettings s_power_profiles[POWER_PROFILE_COUNT] = {
+  [POWER_PROFILE_NORMAL]      = { REFRESH_RETRY_MINUTES, ALL_GROUPS,       true },
+  [POWER_PROFILE_QUIET]       = { 60,                    ESSENTIAL_GROUPS, false },
+  [POWER_PROFILE_LOW_BATTERY] = { 60,                    ESSENTIAL_GROUPS, false },
+  [POWER_PROFILE_SLEEP]       = { 0,                     0,                false },
+};
+
+// MUNI arrival table (must match MUNI_MAX_ROUTES/MUNI_MAX_ARRIVALS in index.js)
+#define MUNI_MAX_ROUTES 3
+#define MUNI_MAX_ARRIVALS 6
+#define MUNI_TABLE_HEADER_SIZE 5
+#define MUNI_TABLE_ROUTE_SIZE (4 + MUNI_MAX_ARRIVALS * 2)
+#define MUNI_ROUTE_SCHEDULED 0x80  // Flag on a label's first byte: arrivals come from the schedule
+
+typedef struct {
+  char label[5];                          // Route name, e.g. "38R"
+  bool scheduled;                         // Timetable arrivals (no real-time data), shown with "*"
+  time_t arrivals[MUNI_MAX_ARRIVALS];     // Unix timestamps, ascending (0 = no data)
+} MuniRoute;
+
+// Detail page forecasts (must match PRECIP_HOURS/TIDE_TABLE_MAX in index.js)
+#define PRECIP_HOURS 6
+#define PRECIP_HOURLY_HEADER_SIZE 4
+#define TIDE_TABLE_MAX 4
+#define TIDE_TABLE_HEADER_SIZE 5
+#define TIDE_TABLE_ENTRY_SIZE 5
+
+typedef struct {
+  time_t start;                  // Start of the first hour (0 = no data)
+  uint8_t chance[PRECIP_HOURS];  // Precipitation probability per hour, 0-100%
+} PrecipForecast;
+
+// 15-minute precipitation nowcast (must match NOWCAST_SLOTS in index.js), read
+// against the clock so the header and "rain in N min" alert advance between syncs
+#define NOWCAST_SLOTS 12
+#define NOWCAST_SLOT_SECONDS (15 * 60)
+#define NOWCAST_HEADER_SIZE 5
+#define NOWCAST_ALERT_MINUTES 60  // Lead time of the "Rain in N min" alert
+
+typedef struct {
+  time_t start;                                 // Start of the first slot (0 = no data)
+  uint8_t count;
+  uint8_t levels[(NOWCAST_SLOTS * 2 + 7) / 8];  // 2 bits per slot, first slot in the low bits
+} Nowcast;
+
+typedef struct {
+  time_t time;
+  int16_t height;  // Tenths of a foot above MLLW
+  uint8_t type;    // 0 = low, 1 = high
+} TideExtreme;
+
+typedef struct {
+  int count;
+  TideExtreme extremes[TIDE_TABLE_MAX];  // Ascending by time
+} TideTable;
+
+// Multi-day forecast (must match FORECAST_DAYS in index.js). Synced about once a
+// day and shifted locally at midnight, so days[0] is always today.
+#define FORECAST_DAYS 5
+#define DAY_TABLE_HEADER_SIZE 5
+#define DAILY_WEATHER_DAY_SIZE 7
+#define DAILY_POLLEN_DAY_SIZE 3
+
+typedef struct {
+  uint8_t weather_code;
+  int16_t temp_min;    // Tenths of a degree Celsius
+  int16_t temp_max;
+  uint8_t precip_max;  // Precipitation probability max, 0-100%
+  uint8_t uv_max;
+} DailyWeather;
+
+typedef struct {
+  time_t start;   // Local midnight of days[0] (0 = no data)
+  uint8_t count;
+  DailyWeather days[FORECAST_DAYS];
+} DailyWeatherTable;
+
+typedef struct {
+  int8_t tree;    // 0-5 (-1 = no data)
+  int8_t grass;
+  int8_t weed;
+} DailyPollen;
+
+typedef struct {
+  time_t start;   // Local midnight of days[0] (0 = no data)
+  uint8_t count;
+  DailyPollen days[FORECAST_DAYS];
+} DailyPollenTable;
+
+// Event log - important events kept in a small persisted ring buffer and sent to
+// the phone on request (EVENT_LOG_REQUEST), so diagnostics need no APP_LOG traffic.
+// Event numbers must match EVENT_NAMES in index.js.
+typedef enum {
+  EVENT_LAUNCH = 1,
+  EVENT_REQUEST,         // value: GROUP_BIT mask requested
+  EVENT_SYNC,            // value: number of fields received
+  EVENT_INBOX_DROPPED,   // value: AppMessageResult
+  EVENT_OUTBOX_FAILED,   // value: AppMessageResult
+  EVENT_POWER_PROFILE,   // value: new PowerProfile
+  EVENT_SCHEMA_SCAN,     // Message keys not sequential, decoding by scan
+  EVENT_CONNECTION,      // value: 1 = phone connected, 0 = disconnected
+  EVENT_TRANSFER         // value: chunks committed, or -1 = rejected (too large)
+} EventType;
+
+#define EVENT_LOG_SIZE 16
+#define EVENT_LOG_ENTRY_SIZE 7  // Wire size: uint32 time, type, int16 value
+
+typedef struct {
+  uint32_t time;
+  int16_t value;
+  uint8_t type;
+} EventLogEntry;
+
+typedef struct {
+  uint8_t next;   // Slot the next event is written to
+  uint8_t count;
+  EventLogEntry entries[EVENT_LOG_SIZE];
+} EventLog;
+
+// Chunked transfers - a sync too large for one inbox message arrives as the
+// Pebble dictionary the phone would have sent, split into numbered chunks. Chunks
+// are staged in order and acknowledged one by one; the dictionary is decoded only
+// once the last chunk is in, so the sync applies completely or not at all. After
+// a disconnect the phone resumes from the acknowledged count (TRANSFER_ACK).
+// The inbox is sized from app_message_inbox_size_maximum() up to INBOX_SIZE_LIMIT
+// and reported to the phone (INBOX_SIZE) so it knows when to chunk, along with
+// the reassembly buffer (TRANSFER_CAPACITY) so it never sends a larger sync. A
+// transfer that doesn't fit anyway is acked with TRANSFER_REJECTED.
+#if defined(PBL_PLATFORM_APLITE)
+#define INBOX_SIZE_LIMIT 512
+#define TRANSFER_BUFFER_SIZE 1024
+#else
+#define INBOX_SIZE_LIMIT 1024
+#define TRANSFER_BUFFER_SIZE 2048
+#endif
+#define TRANSFER_REJECTED 0xFF  // Ack value for a refused transfer (more chunks than any transfer has)
+
+typedef struct {
+  int32_t id;         // Phone-assigned transfer ID (0 = none)
+  uint16_t size;      // Dictionary size announced with chunk 0
+  uint16_t filled;    // Bytes staged so far
+  uint8_t count;      // Chunks in the transfer
+  uint8_t received;   // Chunks staged so far (== count once committed, TRANSFER_REJECTED if refused)
+} Transfer;
+
+// Solar calculator (sunrise equation in fixed point on the Pebble trig tables)
+#define SOLAR_EPOCH 946728000              // J2000.0 (2000-01-01 12:00 UTC) as Unix time
+#define MICRODEG_PER_TURN 360000000LL
 
 // Data storage
 typedef struct {
-  int temperature;
-  int wind_speed;
+  int temperature;  // Tenths of a degree Celsius (converted for display)
+  int wind_speed;   // Tenths of a m/s
   int uv_index;
   int weather_code;
-  int weather_code_tomorrow;
-  int temp_max;
-  int temp_min;
+  DailyWeatherTable daily_weather;  // Today's high/low, tomorrow's icon, detail page
+#if FEATURE_AQI
   int aqi;
+#endif
   int precipitation_probability;  // 0-100%
+  PrecipForecast precip_hourly;   // Header between syncs, detail page
+  Nowcast nowcast;                // 0 = dry, 1 = light, 2 = moderate, 3 = heavy per slot
+#if FEATURE_TIDE
   int tide_time;
   int tide_type; // 0 = low, 1 = high
-  int sunrise;
-  int sunset;
+  TideTable tide_table;           // Detail page only
+#endif
+  int32_t latitude;     // Last known coordinates in 1e-4 degrees (sent on change)
+  int32_t longitude;
+  bool has_coordinates;
+  time_t sunrise;       // Computed on the watch for the current day (0 = none)
+  time_t sunset;
   char location[32];
+#if FEATURE_ALERTS
   char alert_text[64];
   bool alert_active;
-  time_t muni_timestamps[6];  // Unix timestamps for next 6 buses (0 = no data)
-  int pollen_tree;   // Tree pollen 0-5 (-1 = no data)
-  int pollen_grass;  // Grass pollen 0-5 (-1 = no data)
-  int pollen_weed;   // Weed pollen 0-5 (-1 = no data)
-  time_t last_update;
+#endif
+#if FEATURE_MUNI
+  MuniRoute muni_routes[MUNI_MAX_ROUTES];  // Tracked routes in configured order
+  int muni_route_count;
+#endif
+#if FEATURE_POLLEN
+  DailyPollenTable daily_pollen;
+#endif
+  time_t last_update;                  // Time of the last sync received from the phone
+  time_t updated[DATA_GROUP_COUNT];    // Time each group's data was fetched (0 = never)
 } WeatherData;
 
+// Wind speed display units (CONFIG_WIND_UNIT, WIND_UNITS in index.js)
+typedef enum {
+  WIND_UNIT_MPH = 0,
+  WIND_UNIT_KMH,
+  WIND_UNIT_MS,
+  WIND_UNIT_KNOTS,
+  WIND_UNIT_COUNT
+} WindUnit;
+
 typedef struct {
   bool temp_celsius;
-  bool show_aqi;
+  int wind_unit;    // WindUnit
   bool show_uv;
   bool show_wind;
-  bool show_tide;
   bool show_sunrise;
+#if FEATURE_AQI
+  bool show_aqi;
+#endif
+#if FEATURE_TIDE
+  bool show_tide;
+#endif
+#if FEATURE_INVERT
   bool invert_colors;
+#endif
+  int quiet_start;  // Quiet hours start hour (-1 = off)
+  int quiet_end;    // Quiet hours end hour (exclusive)
 } Config;
 
 static WeatherData s_weather_data;
 static Config s_config;
+static time_t s_last_request_time;
+static PowerProfile s_power_profile;
+static uint16_t s_freshness_state;  // 2 bits per DataGroup, see get_freshness_state()
+static bool s_showing_night;        // Day/night variant of the current weather icon
+static EventLog s_event_log;
+static bool s_phone_connected;      // Requests are suspended while the phone is away
+#if FEATURE_TIDE
+static time_t s_shown_tide_time;    // Tide in the grid, re-rendered once it passes (0 = none)
+#endif
+static uint32_t s_inbox_size;
+static Transfer s_transfer;
+static uint8_t s_transfer_buffer[TRANSFER_BUFFER_SIZE];
+
+// AppMessage decoding: one MessageField per message key the watch receives
+typedef enum {
+  FIELD_INT,        // int from a numeric tuple
+  FIELD_TIME,       // time_t from a numeric tuple
+  FIELD_TIMESTAMP,  // time_t, ignored when 0 (group not refreshed by this sync)
+  FIELD_BOOL,
+  FIELD_STRING,     // Copied and truncated to the field size
+  FIELD_HANDLER     // Passed to a custom handler
+} FieldType;
+
+typedef enum {
+  FIELD_TARGET_WEATHER,
+  FIELD_TARGET_CONFIG
+} FieldTarget;
+
+typedef struct {
+  const uint32_t *key;                  // MESSAGE_KEY_* (assigned by the SDK at build time)
+  uint8_t type;                         // FieldType
+  uint8_t target;                       // FieldTarget
+  uint16_t offset;                      // Field offset in its target struct
+  uint16_t size;                        // Field size in bytes
+  uint8_t persist_key;                  // Written whenever the value changes (0 = not persisted)
+  void (*handler)(const Tuple *tuple);  // FIELD_HANDLER only
+} MessageField;
+
+#define WEATHER_FIELD(member) FIELD_TARGET_WEATHER, offsetof(WeatherData, member), sizeof(((WeatherData *)0)->member)
+#define CONFIG_FIELD(member) FIELD_TARGET_CONFIG, offsetof(Config, member), sizeof(((Config *)0)->member)
+#define NO_FIELD FIELD_TARGET_WEATHER, 0, 0
+#define MESSAGE_FIELD_BIT(name) ((uint64_t)1 << MESSAGE_FIELD_##name)
 
 // Forward declarations
-static void update_time();
+static void update_time(struct tm *tick_time);
+#ifdef FITZFACE_BENCHMARK
+static void benchmark_sample_heap();
+static void benchmark_report_hour(int hour);
+#endif
 static void tick_handler(struct tm *tick_time, TimeUnits units_changed);
 static void inbox_received_callback(DictionaryIterator *iterator, void *context);
 static void inbox_dropped_callback(AppMessageResult reason, void *context);
 static void outbox_failed_callback(DictionaryIterator *iterator, AppMessageResult reason, void *context);
 static void outbox_sent_callback(DictionaryIterator *iterator, void *context);
 static void load_persisted_data();
-static void save_weather_data();
+static void save_weather_data(uint64_t received);
 static void load_config();
-static void save_config();
-static void request_weather_update();
+static void request_weather_update(uint8_t groups);
+static void write_transfer_ack(DictionaryIterator *iter);
 static void update_weather_display();
+#if FEATURE_MUNI
 static void update_muni_display();
+static void unpack_muni_table(const Tuple *tuple);
+#endif
+static void unpack_precip_hourly(const Tuple *tuple);
+static void unpack_nowcast(const Tuple *tuple);
+static void unpack_daily_weather(const Tuple *tuple);
+#if FEATURE_POLLEN
+static void unpack_daily_pollen(const Tuple *tuple);
+#endif
+static void send_event_log(const Tuple *tuple);
+#if FEATURE_TIDE
+static void unpack_tide_table(const Tuple *tuple);
+#endif
+
+#include "message_schema.auto.h"
+#if FEATURE_INVERT
 static void apply_color_theme();
+#endif
 
+#if FEATURE_INVERT
 // Color helpers for inversion support
 static GColor get_foreground_color() {
   return s_config.invert_colors ? GColorWhite : GColorBlack;
@@ -195,16 +515,400 @@ static GColor get_background_color() {
 }
 
 static GCompOp get_bitmap_compositing_mode() {
-  // On inverted mode, use OR to make black pixels show as white on black background
-  // This is a workaround - proper solution would require inverted bitmap resources
-  return s_config.invert_colors ? GCompOpOr : GCompOpSet;
+  // Icons are opaque black-on-white 1-bit bitmaps; the dark theme draws them
+  // inverted so a single set of resources serves both themes
+  return s_config.invert_colors ? GCompOpAssignInverted : GCompOpSet;
+}
+#else
+static GColor get_foreground_color() {
+  return GColorBlack;
+}
+
+static GColor get_background_color() {
+  return GColorWhite;
+}
+
+static GCompOp get_bitmap_compositing_mode() {
+  return GCompOpSet;
+}
+#endif
+
+// Record an event in the ring buffer (persisted with the weather data and on exit)
+static void log_event(EventType type, int value) {
+  EventLogEntry *entry = &s_event_log.entries[s_event_log.next];
+  entry->time = (uint32_t)time(NULL);
+  entry->type = type;
+  entry->value = (int16_t)value;
+  s_event_log.next = (s_event_log.next + 1) % EVENT_LOG_SIZE;
+  if (s_event_log.count < EVENT_LOG_SIZE) {
+    s_event_log.count++;
+  }
+}
+
+// Reply to EVENT_LOG_REQUEST with the EVENT_LOG byte array: event count, then
+// each event oldest first as uint32 time, type and int16 value (little endian)
+static void send_event_log(const Tuple *tuple) {
+  uint8_t data[1 + EVENT_LOG_SIZE * EVENT_LOG_ENTRY_SIZE];
+  int pos = 0;
+  data[pos++] = s_event_log.count;
+  for (int i = 0; i < s_event_log.count; i++) {
+    const EventLogEntry *entry =
+      &s_event_log.entries[(s_event_log.next + EVENT_LOG_SIZE - s_event_log.count + i) % EVENT_LOG_SIZE];
+    for (int b = 0; b < 4; b++) {
+      data[pos++] = (entry->time >> (b * 8)) & 0xFF;
+    }
+    data[pos++] = entry->type;
+    data[pos++] = (uint16_t)entry->value & 0xFF;
+    data[pos++] = ((uint16_t)entry->value >> 8) & 0xFF;
+  }
+
+  DictionaryIterator *iter;
+  if (app_message_outbox_begin(&iter) != APP_MSG_OK || iter == NULL) {
+    LOG_WARNING("Event log not sent: outbox busy");
+    return;
+  }
+  dict_write_data(iter, MESSAGE_KEY_EVENT_LOG, data, pos);
+  app_message_outbox_send();
+}
+
+// Whether a data group's subsystem is compiled into this build
+static bool is_group_compiled(DataGroup group) {
+  switch (group) {
+    case DATA_GROUP_AQI:    return FEATURE_AQI;
+    case DATA_GROUP_TIDE:   return FEATURE_TIDE;
+    case DATA_GROUP_MUNI:   return FEATURE_MUNI;
+    case DATA_GROUP_POLLEN: return FEATURE_POLLEN;
+    default:                return true;
+  }
+}
+
+// X position of a grid column for a row with the given number of columns
+static int grid_column_x(int column, int columns, int width) {
+  return column * width / columns;
+}
+
+// Freshness of a data group based on its age and budget
+static Freshness get_group_freshness(DataGroup group, time_t now) {
+  const FreshnessBudget *budget = &s_freshness_budgets[group];
+  time_t updated = s_weather_data.updated[group];
+  if (updated == 0) {
+    return FRESHNESS_FRESH;  // Never synced - nothing to mark, shows defaults
+  }
+
+  int age_minutes = (now - updated) / 60;
+  if (budget->expire_minutes && age_minutes >= budget->expire_minutes) {
+    return FRESHNESS_EXPIRED;
+  }
+  if (budget->stale_minutes && age_minutes >= budget->stale_minutes) {
+    return FRESHNESS_STALE;
+  }
+  return FRESHNESS_FRESH;
+}
+
+// Packed freshness of all groups (2 bits each) - used to detect threshold crossings
+static uint16_t get_freshness_state(time_t now) {
+  uint16_t state = 0;
+  for (int i = 0; i < DATA_GROUP_COUNT; i++) {
+    if (is_group_compiled((DataGroup)i)) {
+      state |= get_group_freshness((DataGroup)i, now) << (i * 2);
+    }
+  }
+  return state;
+}
+
+// Display marker for a group's values ("~" when stale)
+static const char *freshness_marker(DataGroup group) {
+  return get_group_freshness(group, time(NULL)) == FRESHNESS_STALE ? "~" : "";
+}
+
+static bool is_group_expired(DataGroup group) {
+  return get_group_freshness(group, time(NULL)) == FRESHNESS_EXPIRED;
+}
+
+// Groups the power profile syncs that are past their refresh budget (GROUP_BIT mask,
+// 0 = no request due yet or the phone is disconnected)
+static uint8_t get_due_groups(time_t now) {
+  const PowerProfileSettings *profile = &s_power_profiles[s_power_profile];
+  if (!s_phone_connected || profile->groups == 0 || now - s_last_request_time < profile->sync_minutes * 60) {
+    return 0;
+  }
+  uint8_t due = 0;
+  for (int i = 0; i < DATA_GROUP_COUNT; i++) {
+    if (!is_group_compiled((DataGroup)i) || !(profile->groups & GROUP_BIT(i))) {
+      continue;
+    }
+    const FreshnessBudget *budget = &s_freshness_budgets[i];
+    time_t updated = s_weather_data.updated[i];
+    if (updated == 0 || (now - updated) / 60 >= budget->refresh_minutes) {
+      due |= GROUP_BIT(i);
+    }
+  }
+  return due;
+}
+
+// Whether an hour falls in the configured quiet window (which may wrap midnight)
+static bool is_quiet_hour(int hour) {
+  int start = s_config.quiet_start;
+  int end = s_config.quiet_end;
+  if (start < 0 || start == end) {
+    return false;
+  }
+  return start < end ? (hour >= start && hour < end) : (hour >= start || hour < end);
+}
+
+static bool is_wearer_asleep() {
+#if defined(PBL_HEALTH)
+  return (health_service_peek_current_activities() &
+          (HealthActivitySleep | HealthActivityRestfulSleep)) != 0;
+#else
+  return false;
+#endif
+}
+
+// Pick the power profile for the current battery, sleep state and hour
+static void update_power_profile(const struct tm *tick_time) {
+  BatteryChargeState battery = battery_state_service_peek();
+  PowerProfile profile = POWER_PROFILE_NORMAL;
+  if (is_wearer_asleep()) {
+    profile = POWER_PROFILE_SLEEP;
+  } else if (battery.charge_percent <= LOW_BATTERY_PERCENT && !battery.is_charging && !battery.is_plugged) {
+    profile = POWER_PROFILE_LOW_BATTERY;
+  } else if (is_quiet_hour(tick_time->tm_hour)) {
+    profile = POWER_PROFILE_QUIET;
+  }
+
+  if (profile != s_power_profile) {
+    LOG_INFO("Power profile %d -> %d", s_power_profile, profile);
+    log_event(EVENT_POWER_PROFILE, profile);
+    s_power_profile = profile;
+  }
+}
+
+// Micro-degrees to a Pebble trig angle
+static int32_t microdeg_to_trig(int64_t microdeg) {
+  microdeg %= MICRODEG_PER_TURN;
+  if (microdeg < 0) {
+    microdeg += MICRODEG_PER_TURN;
+  }
+  return (int32_t)(microdeg * TRIG_MAX_ANGLE / MICRODEG_PER_TURN);
+}
+
+static int32_t isqrt(int64_t value) {
+  int64_t result = 0;
+  int64_t bit = (int64_t)1 << 40;  // Inputs stay below TRIG_MAX_RATIO^2 < 2^32
+  while (bit > value) {
+    bit >>= 2;
+  }
+  while (bit) {
+    if (value >= result + bit) {
+      value -= result + bit;
+      result = (result >> 1) + bit;
+    } else {
+      result >>= 1;
+    }
+    bit >>= 2;
+  }
+  return (int32_t)result;
+}
+
+// Sunrise and sunset (Unix time) for the local day containing `day` at the given
+// coordinates (1e-4 degrees, east positive). Integer-only sunrise equation:
+// https://en.wikipedia.org/wiki/Sunrise_equation - accurate to about a minute.
+// Returns false when the sun does not rise or set that day (polar day/night).
+static bool compute_sun_times(time_t day, int32_t latitude, int32_t longitude,
+                              time_t *sunrise, time_t *sunset) {
+  struct tm *local = localtime(&day);
+  time_t local_noon = day - (local->tm_hour * 3600 + local->tm_min * 60 + local->tm_sec) + 12 * 3600;
+  int64_t day_number = (local_noon - SOLAR_EPOCH + 43200) / 86400;
+
+  // Mean solar noon at this longitude, seconds since J2000
+  int64_t noon = day_number * 86400 - (int64_t)longitude * 24 / 1000;
+
+  // Mean anomaly M = 357.5291 + 0.98560028 * days (micro-degrees)
+  int64_t anomaly = 357529100LL + noon * 98560028LL / 8640000LL;
+  int32_t m = microdeg_to_trig(anomaly);
+  int32_t sin_m = sin_lookup(m);
+
+  // Equation of center C = 1.9148 sin M + 0.0200 sin 2M + 0.0003 sin 3M
+  int64_t center = (1914800LL * sin_m + 20000LL * sin_lookup((2 * m) % TRIG_MAX_ANGLE) +
+                    300LL * sin_lookup((3 * m) % TRIG_MAX_ANGLE)) / TRIG_MAX_RATIO;
+
+  // Ecliptic longitude and solar transit (0.0053 sin M - 0.0069 sin 2L days)
+  int32_t lambda = microdeg_to_trig(anomaly + center + 282937200LL);
+  int64_t transit = noon + (458LL * sin_m - 596LL * sin_lookup((2 * lambda) % TRIG_MAX_ANGLE)) /
+                    TRIG_MAX_RATIO;
+
+  // Declination: sin d = sin L * sin 23.44
+  int64_t sin_decl = (int64_t)sin_lookup(lambda) * sin_lookup(microdeg_to_trig(23440000)) / TRIG_MAX_RATIO;
+  int64_t cos_decl = isqrt((int64_t)TRIG_MAX_RATIO * TRIG_MAX_RATIO - sin_decl * sin_decl);
+
+  // Hour angle: cos w = (sin -0.833 - sin lat * sin d) / (cos lat * cos d)
+  int32_t lat = microdeg_to_trig((int64_t)latitude * 100);
+  int64_t numerator = (int64_t)sin_lookup(microdeg_to_trig(-833000)) * TRIG_MAX_RATIO -
+                      (int64_t)sin_lookup(lat) * sin_decl;
+  int64_t denominator = (int64_t)cos_lookup(lat) * cos_decl;
+  if (denominator <= 0 || numerator >= denominator || -numerator >= denominator) {
+    return false;
+  }
+
+  int64_t cos_hour = numerator * TRIG_MAX_RATIO / denominator;
+  int32_t sin_hour = isqrt((int64_t)TRIG_MAX_RATIO * TRIG_MAX_RATIO - cos_hour * cos_hour);
+  int32_t hour_angle = atan2_lookup((int16_t)(sin_hour / 2), (int16_t)(cos_hour / 2));
+  int64_t half_day = (int64_t)hour_angle * 86400 / TRIG_MAX_ANGLE;
+
+  *sunrise = (time_t)(SOLAR_EPOCH + transit - half_day);
+  *sunset = (time_t)(SOLAR_EPOCH + transit + half_day);
+  return true;
+}
+
+// Recompute today's sunrise/sunset from the last known coordinates
+static void update_sun_times() {
+  time_t sunrise = 0, sunset = 0;
+  if (!s_weather_data.has_coordinates ||
+      !compute_sun_times(time(NULL), s_weather_data.latitude, s_weather_data.longitude, &sunrise, &sunset)) {
+    sunrise = sunset = 0;
+  }
+  s_weather_data.sunrise = sunrise;
+  s_weather_data.sunset = sunset;
+}
+
+static bool is_night_time(time_t now) {
+  return (s_weather_data.sunrise > 0 && s_weather_data.sunset > 0) &&
+         (now < s_weather_data.sunrise || now > s_weather_data.sunset);
+}
+
+// Integer formatters for the per-minute path (no strftime/snprintf).
+// Each writes a NUL-terminated string and returns the number of chars written;
+// callers size buffers for the worst case.
+static const char *const s_day_names[] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+static const char *const s_month_names[] = {
+  "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+};
+
+static int format_str(char *buffer, const char *str) {
+  int length = 0;
+  while (str[length]) {
+    buffer[length] = str[length];
+    length++;
+  }
+  buffer[length] = '\0';
+  return length;
+}
+
+static int format_uint(char *buffer, unsigned int value) {
+  char digits[10];
+  int count = 0;
+  do {
+    digits[count++] = '0' + value % 10;
+    value /= 10;
+  } while (value);
+  for (int i = 0; i < count; i++) {
+    buffer[i] = digits[count - 1 - i];
+  }
+  buffer[count] = '\0';
+  return count;
+}
+
+static int format_int(char *buffer, int value) {
+  if (value < 0) {
+    buffer[0] = '-';
+    return 1 + format_uint(buffer + 1, (unsigned int)(-value));
+  }
+  return format_uint(buffer, (unsigned int)value);
+}
+
+static int format_two_digits(char *buffer, int value) {
+  buffer[0] = '0' + (value / 10) % 10;
+  buffer[1] = '0' + value % 10;
+  buffer[2] = '\0';
+  return 2;
+}
+
+// "HH:MM", or "H:MM" without hour padding
+static int format_hhmm(char *buffer, int hour, int minute, bool pad_hour) {
+  int pos = (pad_hour || hour >= 10) ? format_two_digits(buffer, hour) : format_uint(buffer, hour);
+  buffer[pos++] = ':';
+  return pos + format_two_digits(buffer + pos, minute);
+}
+
+// Signed degrees, e.g. "-3°" (degree sign is 2 bytes of UTF-8)
+static int format_degrees(char *buffer, int value) {
+  int pos = format_int(buffer, value);
+  return pos + format_str(buffer + pos, "°");
+}
+
+// Integer division rounding halves away from zero
+static int div_round(int value, int divisor) {
+  return value >= 0 ? (value + divisor / 2) / divisor : -((-value + divisor / 2) / divisor);
+}
+
+// Whole degrees in the configured unit from tenths of a degree Celsius
+static int display_temperature(int tenths_celsius) {
+  return s_config.temp_celsius ? div_round(tenths_celsius, 10) : div_round(tenths_celsius * 9 + 1600, 50);
+}
+
+// Wind units by WindUnit: multiplier per tenth of a m/s (x10000) and label
+static const struct {
+  uint16_t factor;
+  const char *label;
+} s_wind_units[WIND_UNIT_COUNT] = {
+  { 2237, "mph" },
+  { 3600, "km/h" },
+  { 1000, "m/s" },
+  { 1944, "kn" },
+};
+
+// Wind speed in the configured unit, e.g. "12mph"
+static int format_wind_speed(char *buffer, int tenths_ms) {
+  int unit = s_config.wind_unit >= 0 && s_config.wind_unit < WIND_UNIT_COUNT ? s_config.wind_unit : WIND_UNIT_MPH;
+  int pos = format_int(buffer, div_round(tenths_ms * s_wind_units[unit].factor, 10000));
+  return pos + format_str(buffer + pos, s_wind_units[unit].label);
+}
+
+// Short date "Sun, Oct 18" (same as strftime "%a, %b %d")
+static int format_short_date(char *buffer, const struct tm *tm_date) {
+  int pos = format_str(buffer, s_day_names[tm_date->tm_wday % 7]);
+  pos += format_str(buffer + pos, ", ");
+  pos += format_str(buffer + pos, s_month_names[tm_date->tm_mon % 12]);
+  buffer[pos++] = ' ';
+  return pos + format_two_digits(buffer + pos, tm_date->tm_mday);
+}
+
+// Minute list joined by a separator, e.g. "3, 12" or "3|7|-" (negative = "-")
+static int format_minute_list(char *buffer, const int *minutes, int count, const char *separator) {
+  int pos = 0;
+  buffer[0] = '\0';
+  for (int i = 0; i < count; i++) {
+    if (i > 0) {
+      pos += format_str(buffer + pos, separator);
+    }
+    pos += minutes[i] < 0 ? format_str(buffer + pos, "-") : format_uint(buffer + pos, minutes[i]);
+  }
+  return pos;
+}
+
+// Tenths with one decimal, e.g. "5.1" or "-0.3"
+static int format_tenths(char *buffer, int value) {
+  int pos = 0;
+  if (value < 0) {
+    buffer[pos++] = '-';
+    value = -value;
+  }
+  pos += format_uint(buffer + pos, value / 10);
+  buffer[pos++] = '.';
+  buffer[pos++] = '0' + value % 10;
+  buffer[pos] = '\0';
+  return pos;
 }
 
 // Utility: Format time from Unix timestamp (24-hour format)
 static void format_time_from_timestamp(int timestamp, char *buffer, size_t size) {
+  if (size < 6) {
+    return;
+  }
   time_t t = (time_t)timestamp;
   struct tm *tm_info = localtime(&t);
-  strftime(buffer, size, "%H:%M", tm_info);
+  format_hhmm(buffer, tm_info->tm_hour, tm_info->tm_min, true);
 }
 
 // Get weather icon resource based on weather code
@@ -212,48 +916,44 @@ static void format_time_from_timestamp(int timestamp, char *buffer, size_t size)
 static uint32_t get_weather_icon_resource(int weather_code, bool use_current_time_for_night) {
   bool is_night = false;
   if (use_current_time_for_night) {
-    time_t now = time(NULL);
-    is_night = (s_weather_data.sunrise > 0 && s_weather_data.sunset > 0) &&
-               (now < s_weather_data.sunrise || now > s_weather_data.sunset);
+    is_night = is_night_time(time(NULL));
   }
 
-  bool inverted = s_config.invert_colors;
-
   switch (weather_code) {
     case 0: // Clear sky
       if (is_night) {
-        return inverted ? RESOURCE_ID_ICON_MOON_INVERTED : RESOURCE_ID_ICON_MOON;
+        return RESOURCE_ID_ICON_MOON;
       } else {
-        return inverted ? RESOURCE_ID_ICON_SUN_INVERTED : RESOURCE_ID_ICON_SUN;
+        return RESOURCE_ID_ICON_SUN;
       }
 
     case 1: // Mainly clear
     case 2: // Partly cloudy
-      return inverted ? RESOURCE_ID_ICON_CLOUD_INVERTED : RESOURCE_ID_ICON_CLOUD;
+      return RESOURCE_ID_ICON_CLOUD;
 
     case 3: // Overcast
     case 45: // Fog
     case 48: // Depositing rime fog
-      return inverted ? RESOURCE_ID_ICON_CLOUDS_INVERTED : RESOURCE_ID_ICON_CLOUDS;
+      return RESOURCE_ID_ICON_CLOUDS;
 
     case 51: // Drizzle: Light
     case 53: // Drizzle: Moderate
     case 55: // Drizzle: Dense
     case 56: // Freezing Drizzle: Light
     case 57: // Freezing Drizzle: Dense
-      return inverted ? RESOURCE_ID_ICON_RAIN_LIGHT_INVERTED : RESOURCE_ID_ICON_RAIN_LIGHT;
+      return RESOURCE_ID_ICON_RAIN_LIGHT;
 
     case 61: // Rain: Slight
     case 66: // Freezing Rain: Light
     case 80: // Rain showers: Slight
-      return inverted ? RESOURCE_ID_ICON_RAIN_MEDIUM_INVERTED : RESOURCE_ID_ICON_RAIN_MEDIUM;
+      return RESOURCE_ID_ICON_RAIN_MEDIUM;
 
     case 63: // Rain: Moderate
     case 65: // Rain: Heavy
     case 67: // Freezing Rain: Heavy
     case 81: // Rain showers: Moderate
     case 82: // Rain showers: Violent
-      return inverted ? RESOURCE_ID_ICON_RAIN_HEAVY_INVERTED : RESOURCE_ID_ICON_RAIN_HEAVY;
+      return RESOURCE_ID_ICON_RAIN_HEAVY;
 
     case 71: // Snow fall: Slight
     case 73: // Snow fall: Moderate
@@ -261,87 +961,275 @@ static uint32_t get_weather_icon_resource(int weather_code, bool use_current_tim
     case 77: // Snow grains
     case 85: // Snow showers: Slight
     case 86: // Snow showers: Heavy
-      return inverted ? RESOURCE_ID_ICON_SNOW_INVERTED : RESOURCE_ID_ICON_SNOW;
+      return RESOURCE_ID_ICON_SNOW;
 
     case 95: // Thunderstorm: Slight or moderate
     case 96: // Thunderstorm with slight hail
     case 99: // Thunderstorm with heavy hail
-      return inverted ? RESOURCE_ID_ICON_LIGHTNING_INVERTED : RESOURCE_ID_ICON_LIGHTNING;
+      return RESOURCE_ID_ICON_LIGHTNING;
 
     default:
       if (is_night) {
-        return inverted ? RESOURCE_ID_ICON_MOON_INVERTED : RESOURCE_ID_ICON_MOON;
+        return RESOURCE_ID_ICON_MOON;
       } else {
-        return inverted ? RESOURCE_ID_ICON_SUN_INVERTED : RESOURCE_ID_ICON_SUN;
+        return RESOURCE_ID_ICON_SUN;
       }
   }
 }
 
 // Update time display
-static void update_time() {
-  time_t temp = time(NULL);
-  struct tm *tick_time = localtime(&temp);
-
+static void update_time(struct tm *tick_time) {
   static char s_time_buffer[8];
   static char s_date_buffer[16];
+  static int s_date_day = -1;  // tm_yday the date was last formatted for
 
-  // Time: HH:MM
+  // Time: HH:MM (12-hour format without leading zero)
   if (clock_is_24h_style()) {
-    strftime(s_time_buffer, sizeof(s_time_buffer), "%H:%M", tick_time);
+    format_hhmm(s_time_buffer, tick_time->tm_hour, tick_time->tm_min, true);
   } else {
-    strftime(s_time_buffer, sizeof(s_time_buffer), "%I:%M", tick_time);
-    // Remove leading zero for 12-hour format
-    if (s_time_buffer[0] == '0') {
-      memmove(s_time_buffer, s_time_buffer + 1, strlen(s_time_buffer));
-    }
+    int hour = tick_time->tm_hour % 12;
+    format_hhmm(s_time_buffer, hour ? hour : 12, tick_time->tm_min, false);
   }
+  text_layer_set_text(s_time_layer, s_time_buffer);
 
-  // Date: DAY, MON DD
-  strftime(s_date_buffer, sizeof(s_date_buffer), "%a, %b %d", tick_time);
+  // Date: DAY, MON DD - only reformatted on day rollover
+  if (tick_time->tm_yday != s_date_day) {
+    s_date_day = tick_time->tm_yday;
+    format_short_date(s_date_buffer, tick_time);
+    text_layer_set_text(s_date_layer, s_date_buffer);
+  }
+}
 
-  text_layer_set_text(s_time_layer, s_time_buffer);
-  text_layer_set_text(s_date_layer, s_date_buffer);
+#if FEATURE_MUNI
+// Collect minutes until the next future arrivals of a route
+static int get_muni_future_minutes(const MuniRoute *route, time_t now, int *minutes, int max) {
+  int count = 0;
+  for (int i = 0; i < MUNI_MAX_ARRIVALS && count < max; i++) {
+    if (route->arrivals[i] > 0) {
+      int remaining = (route->arrivals[i] - now) / 60;
+      if (remaining > 0) {  // Only future arrivals
+        minutes[count++] = remaining;
+      }
+    }
+  }
+  return count;
+}
+
+// Marker in front of MUNI countdowns: "*" for scheduled arrivals, else the freshness marker
+static const char *muni_marker(bool scheduled) {
+  return scheduled ? "*" : freshness_marker(DATA_GROUP_MUNI);
 }
 
 // Update MUNI bus countdown display (recalculated every minute from timestamps)
+// One route shows its next 2 arrivals ("3, 12"); several routes show the next
+// arrival of each side by side in configured order ("3|7|12", "-" = none)
 static void update_muni_display() {
   static char muni_buffer[16];
   time_t now = time(NULL);
-  int future_buses[6];
-  int count = 0;
+  int future_buses[MUNI_MAX_ROUTES];
 
-  // Find all future arrivals from timestamps
-  for (int i = 0; i < 6; i++) {
-    if (s_weather_data.muni_timestamps[i] > 0) {
-      int minutes = (s_weather_data.muni_timestamps[i] - now) / 60;
-      if (minutes > 0) {  // Only future arrivals
-        future_buses[count++] = minutes;
-      }
-    }
+  if (s_weather_data.muni_route_count == 0 || is_group_expired(DATA_GROUP_MUNI)) {
+    text_layer_set_text(s_muni_layer, ":)");
+    return;
   }
 
-  // Display next 2 future buses
-  if (count >= 2) {
-    snprintf(muni_buffer, sizeof(muni_buffer), "%d, %d",
-             future_buses[0], future_buses[1]);
-  } else if (count == 1) {
-    snprintf(muni_buffer, sizeof(muni_buffer), "%d", future_buses[0]);
+  if (s_weather_data.muni_route_count == 1) {
+    int count = get_muni_future_minutes(&s_weather_data.muni_routes[0], now, future_buses, 2);
+
+    // Display next 2 future buses (marked when predictions are stale)
+    if (count > 0) {
+      int pos = format_str(muni_buffer, muni_marker(s_weather_data.muni_routes[0].scheduled));
+      format_minute_list(muni_buffer + pos, future_buses, count, ", ");
+    } else {
+      // No future buses - show placeholder
+      format_str(muni_buffer, ":)");
+    }
   } else {
-    // No future buses - show placeholder
-    strcpy(muni_buffer, ":)");
+    bool any_future = false;
+    bool any_scheduled = false;
+    for (int r = 0; r < s_weather_data.muni_route_count; r++) {
+      int minutes;
+      bool found = get_muni_future_minutes(&s_weather_data.muni_routes[r], now, &minutes, 1) > 0;
+      any_future |= found;
+      any_scheduled |= found && s_weather_data.muni_routes[r].scheduled;
+      future_buses[r] = found ? minutes : -1;
+    }
+    if (any_future) {
+      // Worst case "~1092|1092|1092" fits the buffer (arrival offsets are uint16 seconds)
+      int pos = format_str(muni_buffer, muni_marker(any_scheduled));
+      format_minute_list(muni_buffer + pos, future_buses, s_weather_data.muni_route_count, "|");
+    } else {
+      format_str(muni_buffer, ":)");
+    }
   }
 
   text_layer_set_text(s_muni_layer, muni_buffer);
 }
+#endif
+
+// Precipitation probability for the current hour from the hourly forecast, so the
+// header keeps advancing between syncs (falls back to the synced value)
+static int current_precip_probability(time_t now) {
+  const PrecipForecast *forecast = &s_weather_data.precip_hourly;
+  if (forecast->start && now >= forecast->start && now - forecast->start < PRECIP_HOURS * 3600) {
+    return forecast->chance[(now - forecast->start) / 3600];
+  }
+  return s_weather_data.precipitation_probability;
+}
+
+static int nowcast_slot_level(const Nowcast *nowcast, int slot) {
+  return (nowcast->levels[slot / 4] >> ((slot % 4) * 2)) & 0x3;
+}
+
+// Minutes until the nowcast next shows rain (0 = raining now, -1 = none ahead or
+// no nowcast covering now)
+static int nowcast_minutes_to_rain(time_t now) {
+  const Nowcast *nowcast = &s_weather_data.nowcast;
+  if (!nowcast->start || now < nowcast->start) {
+    return -1;
+  }
+  int first = (now - nowcast->start) / NOWCAST_SLOT_SECONDS;
+  for (int slot = first; slot < nowcast->count; slot++) {
+    if (nowcast_slot_level(nowcast, slot) > 0) {
+      time_t slot_start = nowcast->start + slot * NOWCAST_SLOT_SECONDS;
+      return slot == first ? 0 : (int)(slot_start - now + 59) / 60;
+    }
+  }
+  return -1;
+}
+
+// What the nowcast currently adds to the display: minutes until rain within the
+// alert lead time (0 = raining now), or -1 for nothing. A change means a redraw.
+static int nowcast_display_state(time_t now) {
+  if (is_group_expired(DATA_GROUP_WEATHER)) {
+    return -1;
+  }
+  int minutes = nowcast_minutes_to_rain(now);
+  return minutes <= NOWCAST_ALERT_MINUTES ? minutes : -1;
+}
+
+#if FEATURE_TIDE
+// Next high/low tide after now from the tide table (falls back to the synced next tide)
+static bool get_next_tide(time_t now, time_t *tide_time, int *tide_type) {
+  const TideTable *table = &s_weather_data.tide_table;
+  for (int i = 0; i < table->count; i++) {
+    if (table->extremes[i].time > now) {
+      *tide_time = table->extremes[i].time;
+      *tide_type = table->extremes[i].type;
+      return true;
+    }
+  }
+  *tide_time = s_weather_data.tide_time;
+  *tide_type = s_weather_data.tide_type;
+  return *tide_time > now;
+}
+#endif
+
+// Drop the days before today from a day table whose days[0] starts at *start
+// (local midnight). Rounds to whole days so 23 and 25 hour DST days line up.
+static void advance_day_table(time_t *start, uint8_t *count, void *days, size_t day_size, time_t today) {
+  if (*start == 0 || today <= *start) {
+    return;
+  }
+  int passed = (today - *start + SECONDS_PER_DAY / 2) / SECONDS_PER_DAY;
+  if (passed >= *count) {
+    *count = 0;
+  } else if (passed > 0) {
+    memmove(days, (uint8_t *)days + passed * day_size, (*count - passed) * day_size);
+    *count -= passed;
+  }
+  *start = today;
+}
+
+// Shift the multi-day tables so days[0] is today (at midnight, on launch and after a sync)
+static void shift_daily_forecast() {
+  time_t today = time_start_of_today();
+  DailyWeatherTable *weather = &s_weather_data.daily_weather;
+  advance_day_table(&weather->start, &weather->count, weather->days, sizeof(DailyWeather), today);
+#if FEATURE_POLLEN
+  DailyPollenTable *pollen = &s_weather_data.daily_pollen;
+  advance_day_table(&pollen->start, &pollen->count, pollen->days, sizeof(DailyPollen), today);
+#endif
+}
+
+// Forecast for a day counted from today (0 = today), NULL when the table doesn't cover it
+static const DailyWeather *get_daily_weather(int day) {
+  const DailyWeatherTable *table = &s_weather_data.daily_weather;
+  return day < table->count ? &table->days[day] : NULL;
+}
+
+#if FEATURE_POLLEN
+// Pollen levels for a day counted from today, NULL when not covered or all unknown
+static const DailyPollen *get_daily_pollen(int day) {
+  const DailyPollenTable *table = &s_weather_data.daily_pollen;
+  if (day >= table->count) {
+    return NULL;
+  }
+  const DailyPollen *pollen = &table->days[day];
+  return pollen->tree >= 0 || pollen->grass >= 0 || pollen->weed >= 0 ? pollen : NULL;
+}
+#endif
+
+// Precipitation header (top left corner) and alert line. The nowcast shows "Rain"
+// while it is raining and replaces the synced alert with "Rain in N min" within
+// NOWCAST_ALERT_MINUTES of rain starting; otherwise the hourly probability and
+// the phone's alert are shown.
+static void update_precip_display(time_t now) {
+  static char precip_buffer[8];
+  bool weather_expired = is_group_expired(DATA_GROUP_WEATHER);
+  int nowcast = nowcast_display_state(now);
+
+  int precip = current_precip_probability(now);
+  if (nowcast == 0) {
+    text_layer_set_text(s_precip_layer, "Rain");
+  } else if (precip >= 0 && !weather_expired) {
+    if (precip < 100) {
+      format_two_digits(precip_buffer, precip);
+    } else {
+      format_uint(precip_buffer, precip);
+    }
+    text_layer_set_text(s_precip_layer, precip_buffer);
+  } else {
+    text_layer_set_text(s_precip_layer, "");
+  }
+
+#if FEATURE_ALERTS
+  // Weather alert (show/hide based on active state, dropped once the forecast expires)
+  static char nowcast_alert[20];
+  if (nowcast > 0) {
+    int pos = format_str(nowcast_alert, "Rain in ");
+    pos += format_uint(nowcast_alert + pos, nowcast);
+    format_str(nowcast_alert + pos, " min");
+    text_layer_set_text(s_alert_layer, nowcast_alert);
+    layer_set_hidden(text_layer_get_layer(s_alert_layer), false);
+  } else if (s_weather_data.alert_active && !weather_expired) {
+    text_layer_set_text(s_alert_layer, s_weather_data.alert_text);
+    layer_set_hidden(text_layer_get_layer(s_alert_layer), false);
+  } else {
+    layer_set_hidden(text_layer_get_layer(s_alert_layer), true);
+  }
+#endif
+}
+
+// Record the nowcast state after a tick or sync redraw. Rain newly ahead (not
+// just the countdown moving) vibrates like a new alert; the state at launch is
+// seeded in init() so opening the face doesn't.
+static void update_shown_nowcast(int nowcast) {
+#if FEATURE_ALERTS
+  if (s_shown_nowcast < 0 && nowcast > 0 && s_power_profiles[s_power_profile].vibrate) {
+    vibes_short_pulse();
+  }
+#endif
+  s_shown_nowcast = nowcast;
+}
 
 // Update weather display
 static void update_weather_display() {
   static char wind_buffer[32];
   static char uv_buffer[16];
-  static char aqi_buffer[16];
   static char temp_min_buffer[8];
-  static char temp_current_buffer[8];
-  static char temp_max_buffer[8];
+  static char temp_current_buffer[12];
+  static char temp_max_buffer[12];
 
   // Weather icon (uses current time for day/night)
   if (s_weather_icon) {
@@ -350,82 +1238,99 @@ static void update_weather_display() {
   uint32_t icon_resource = get_weather_icon_resource(s_weather_data.weather_code, true);
   s_weather_icon = gbitmap_create_with_resource(icon_resource);
   bitmap_layer_set_bitmap(s_weather_icon_layer, s_weather_icon);
+  s_showing_night = is_night_time(time(NULL));
 
   // Tomorrow's weather icon (always show daytime icon)
   if (s_weather_icon_tomorrow) {
     gbitmap_destroy(s_weather_icon_tomorrow);
   }
-  uint32_t icon_resource_tomorrow = get_weather_icon_resource(s_weather_data.weather_code_tomorrow, false);
+  const DailyWeather *tomorrow = get_daily_weather(1);
+  uint32_t icon_resource_tomorrow = get_weather_icon_resource(tomorrow ? tomorrow->weather_code : 0, false);
   s_weather_icon_tomorrow = gbitmap_create_with_resource(icon_resource_tomorrow);
   bitmap_layer_set_bitmap(s_weather_icon_tomorrow_layer, s_weather_icon_tomorrow);
 
-  // Location
-  text_layer_set_text(s_location_layer, s_weather_data.location);
-
-  // Weather alert (show/hide based on active state)
-  if (s_weather_data.alert_active) {
-    text_layer_set_text(s_alert_layer, s_weather_data.alert_text);
-    layer_set_hidden(text_layer_get_layer(s_alert_layer), false);
+  // Location (replaced by the offline indicator while the phone is disconnected)
+  static char location_buffer[34];
+  if (s_phone_connected) {
+    int pos = format_str(location_buffer, freshness_marker(DATA_GROUP_LOCATION));
+    format_str(location_buffer + pos, s_weather_data.location);
   } else {
-    layer_set_hidden(text_layer_get_layer(s_alert_layer), true);
+    format_str(location_buffer, "Offline");
   }
+  text_layer_set_text(s_location_layer, location_buffer);
+
+  bool weather_expired = is_group_expired(DATA_GROUP_WEATHER);
+  const char *weather_marker = freshness_marker(DATA_GROUP_WEATHER);
 
+  // Precipitation header and alert line (also refreshed by the tick as the nowcast advances)
+  update_precip_display(time(NULL));
+
+#if FEATURE_MUNI
   // MUNI bus countdown updated separately (recalculated every minute)
   update_muni_display();
+#endif
 
-  // Precipitation probability display (top left corner) - show as 2-digit percentage
-  static char precip_buffer[8];
-  if (s_weather_data.precipitation_probability >= 0) {
-    snprintf(precip_buffer, sizeof(precip_buffer), "%02d", s_weather_data.precipitation_probability);
-    text_layer_set_text(s_precip_layer, precip_buffer);
-  } else {
-    text_layer_set_text(s_precip_layer, "");
-  }
-
-  // Pollen display (top right corner) - show worst type + level
+#if FEATURE_POLLEN
+  // Pollen display (top right corner) - show worst type + level, hidden while
+  // there is no data or every type is at 0
   static char pollen_buffer[8];
-  if (s_weather_data.pollen_tree >= 0 || s_weather_data.pollen_grass >= 0 || s_weather_data.pollen_weed >= 0) {
-    // Find highest pollen count
-    int max_pollen = 0;
-    char pollen_type = 'P';  // Default to 'P' for testing when all are 0
-
-    if (s_weather_data.pollen_tree > max_pollen) {
-      max_pollen = s_weather_data.pollen_tree;
+  const DailyPollen *pollen = get_daily_pollen(0);
+  int max_pollen = 0;
+  char pollen_type = '\0';
+  if (pollen && !is_group_expired(DATA_GROUP_POLLEN)) {
+    if (pollen->tree > max_pollen) {
+      max_pollen = pollen->tree;
       pollen_type = 'T';
     }
-    if (s_weather_data.pollen_grass > max_pollen) {
-      max_pollen = s_weather_data.pollen_grass;
+    if (pollen->grass > max_pollen) {
+      max_pollen = pollen->grass;
       pollen_type = 'G';
     }
-    if (s_weather_data.pollen_weed > max_pollen) {
-      max_pollen = s_weather_data.pollen_weed;
+    if (pollen->weed > max_pollen) {
+      max_pollen = pollen->weed;
       pollen_type = 'W';
     }
-
-    // TEMPORARY: Always show pollen for testing (even when 0)
-    snprintf(pollen_buffer, sizeof(pollen_buffer), "%c%d", pollen_type, max_pollen);
+  }
+  if (pollen_type) {
+    int pos = format_str(pollen_buffer, freshness_marker(DATA_GROUP_POLLEN));
+    pollen_buffer[pos++] = pollen_type;
+    format_uint(pollen_buffer + pos, max_pollen);
     text_layer_set_text(s_pollen_layer, pollen_buffer);
   } else {
-    // No pollen data
     text_layer_set_text(s_pollen_layer, "");
   }
+#endif
 
   // Temperature grid - centered layout
   // Current temp - center column (large)
-  snprintf(temp_current_buffer, sizeof(temp_current_buffer), "%d°", s_weather_data.temperature);
-  text_layer_set_text(s_temp_current_layer, temp_current_buffer);
+  if (weather_expired) {
+    text_layer_set_text(s_temp_current_layer, "--");
+  } else {
+    int pos = format_str(temp_current_buffer, weather_marker);
+    format_degrees(temp_current_buffer + pos, display_temperature(s_weather_data.temperature));
+    text_layer_set_text(s_temp_current_layer, temp_current_buffer);
+  }
 
-  // Combined low/high - right column (format: "53°|59°" centered)
-  snprintf(temp_max_buffer, sizeof(temp_max_buffer), "%d|%d",
-           s_weather_data.temp_min, s_weather_data.temp_max);
-  text_layer_set_text(s_temp_max_layer, temp_max_buffer);
+  // Combined low/high - right column (format: "53|59" centered), from today's
+  // entry in the daily forecast so it stays valid between syncs
+  const DailyWeather *today = get_daily_weather(0);
+  if (today) {
+    int pos = format_str(temp_max_buffer, freshness_marker(DATA_GROUP_DAILY));
+    pos += format_int(temp_max_buffer + pos, display_temperature(today->temp_min));
+    temp_max_buffer[pos++] = '|';
+    format_int(temp_max_buffer + pos, display_temperature(today->temp_max));
+    text_layer_set_text(s_temp_max_layer, temp_max_buffer);
+  } else {
+    text_layer_set_text(s_temp_max_layer, "--");
+  }
 
   // temp_min_layer is hidden, not used
   text_layer_set_text(s_temp_min_layer, "");
 
-  // Wind (if enabled) - with mph unit
-  if (s_config.show_wind) {
-    snprintf(wind_buffer, sizeof(wind_buffer), "%dmph", s_weather_data.wind_speed);
+  // Wind (if enabled) - in the configured unit
+  if (s_config.show_wind && !weather_expired) {
+    int pos = format_str(wind_buffer, weather_marker);
+    format_wind_speed(wind_buffer + pos, s_weather_data.wind_speed);
     text_layer_set_text(s_wind_layer, wind_buffer);
     layer_set_hidden(text_layer_get_layer(s_wind_layer), false);
   } else {
@@ -433,35 +1338,49 @@ static void update_weather_display() {
   }
 
   // UV Index (if enabled) - with UV label
-  if (s_config.show_uv) {
-    snprintf(uv_buffer, sizeof(uv_buffer), "UV%d", s_weather_data.uv_index);
+  if (s_config.show_uv && !weather_expired) {
+    int pos = format_str(uv_buffer, weather_marker);
+    pos += format_str(uv_buffer + pos, "UV");
+    format_int(uv_buffer + pos, s_weather_data.uv_index);
     text_layer_set_text(s_uv_layer, uv_buffer);
     layer_set_hidden(text_layer_get_layer(s_uv_layer), false);
   } else {
     layer_set_hidden(text_layer_get_layer(s_uv_layer), true);
   }
 
+#if FEATURE_AQI
   // AQI (if enabled) - with AQI label
-  if (s_config.show_aqi) {
-    snprintf(aqi_buffer, sizeof(aqi_buffer), "AQI%d", s_weather_data.aqi);
+  static char aqi_buffer[16];
+  if (s_config.show_aqi && !is_group_expired(DATA_GROUP_AQI)) {
+    int pos = format_str(aqi_buffer, freshness_marker(DATA_GROUP_AQI));
+    pos += format_str(aqi_buffer + pos, "AQI");
+    format_int(aqi_buffer + pos, s_weather_data.aqi);
     text_layer_set_text(s_aqi_layer, aqi_buffer);
     layer_set_hidden(text_layer_get_layer(s_aqi_layer), false);
   } else {
     layer_set_hidden(text_layer_get_layer(s_aqi_layer), true);
   }
+#endif
 
-  // Tide (if enabled) - H/L with 24-hour time
+#if FEATURE_TIDE
+  // Tide (if enabled) - next H/L from the tide table with 24-hour time, hidden
+  // once every predicted tide has passed
   static char tide_display[16];
-  if (s_config.show_tide && s_weather_data.tide_time > 0) {
-    char tide_time_str[16];
-    format_time_from_timestamp(s_weather_data.tide_time, tide_time_str, sizeof(tide_time_str));
-    snprintf(tide_display, sizeof(tide_display), "%s %s",
-             s_weather_data.tide_type == 1 ? "H" : "L", tide_time_str);
+  time_t tide_time;
+  int tide_type;
+  s_shown_tide_time = 0;
+  if (s_config.show_tide && get_next_tide(time(NULL), &tide_time, &tide_type) &&
+      !is_group_expired(DATA_GROUP_TIDE)) {
+    int pos = format_str(tide_display, freshness_marker(DATA_GROUP_TIDE));
+    pos += format_str(tide_display + pos, tide_type == 1 ? "H " : "L ");
+    format_time_from_timestamp(tide_time, tide_display + pos, sizeof(tide_display) - pos);
     text_layer_set_text(s_tide_layer, tide_display);
     layer_set_hidden(text_layer_get_layer(s_tide_layer), false);
+    s_shown_tide_time = tide_time;
   } else {
     layer_set_hidden(text_layer_get_layer(s_tide_layer), true);
   }
+#endif
 
   // Sunrise/Sunset (if enabled) - bitmap arrows with 24-hour time
   static char sunrise_str[16], sunset_str[16];
@@ -488,297 +1407,743 @@ static void update_weather_display() {
 
 // Tick handler - called every minute
 static void tick_handler(struct tm *tick_time, TimeUnits units_changed) {
-  update_time();
-  update_muni_display();  // Recalculate MUNI countdown every minute
+  update_time(tick_time);
+
+  // New day: sunrise/sunset are recomputed and the multi-day forecast moves up a
+  // day locally, no sync needed
+  if (units_changed & DAY_UNIT) {
+    update_sun_times();
+    shift_daily_forecast();
+  }
 
-  // Request weather update every 30 minutes (at :00 and :30)
-  if (tick_time->tm_min == 0 || tick_time->tm_min == 30) {
-    request_weather_update();
+  // Re-render data only when a group crosses a freshness threshold, the sun
+  // rises or sets (day/night icon), the hour changes (hourly precip), the shown
+  // tide passes or the day rolls over (sunrise/sunset times, daily forecast)
+  time_t now = time(NULL);
+  uint16_t freshness_state = get_freshness_state(now);
+  int nowcast = nowcast_display_state(now);
+  bool tide_passed = false;
+#if FEATURE_TIDE
+  tide_passed = s_shown_tide_time && now >= s_shown_tide_time;
+#endif
+  if (freshness_state != s_freshness_state || is_night_time(now) != s_showing_night ||
+      tide_passed || (units_changed & (HOUR_UNIT | DAY_UNIT))) {
+    s_freshness_state = freshness_state;
+    update_weather_display();  // Also refreshes the MUNI countdown
+  } else {
+    // The nowcast moved on (rain started or stopped, or the countdown ticked)
+    if (nowcast != s_shown_nowcast) {
+      update_precip_display(now);
+    }
+#if FEATURE_MUNI
+    update_muni_display();  // Recalculate MUNI countdown every minute
+#endif
+  }
+  update_shown_nowcast(nowcast);
+
+  // Request the data groups that are past their refresh budget
+  update_power_profile(tick_time);
+  uint8_t due_groups = get_due_groups(now);
+  if (due_groups) {
+    request_weather_update(due_groups);
+  }
+
+#ifdef FITZFACE_BENCHMARK
+  benchmark_sample_heap();
+  if (units_changed & HOUR_UNIT) {
+    benchmark_report_hour((tick_time->tm_hour + 23) % 24);
+  }
+#endif
+}
+
+#ifdef FITZFACE_BENCHMARK
+// Average cost of the per-minute tick path. Build with -DFITZFACE_BENCHMARK
+// and read the app log; cycles = microseconds * CPU MHz (64 on aplite).
+#define BENCHMARK_TICKS 500
+static void benchmark_tick_path() {
+  time_t now = time(NULL);
+  struct tm tick_time = *localtime(&now);
+  s_last_request_time = now;  // Keep the benchmark from sending refresh requests
+
+  uint16_t start_ms, end_ms;
+  time_t start = time_ms(NULL, &start_ms);
+  for (int i = 0; i < BENCHMARK_TICKS; i++) {
+    tick_handler(&tick_time, MINUTE_UNIT);
+  }
+  time_t end = time_ms(NULL, &end_ms);
+
+  int elapsed_ms = (int)(end - start) * 1000 + end_ms - start_ms;
+  APP_LOG(APP_LOG_LEVEL_INFO, "Tick path: %d us/tick over %d ticks",
+          elapsed_ms * 1000 / BENCHMARK_TICKS, BENCHMARK_TICKS);
+  s_bench = (BenchmarkCounters) { 0 };  // The timeline starts after the tick path run
+}
+
+// Bytes of a serialized AppMessage dictionary
+static uint32_t benchmark_dict_size(const DictionaryIterator *iterator) {
+  return (const uint8_t *)iterator->end - (const uint8_t *)iterator->dictionary;
+}
+
+static void benchmark_sample_heap() {
+  uint32_t used = heap_bytes_used();
+  if (used > s_bench.heap_used_max) {
+    s_bench.heap_used_max = used;
   }
 }
 
-// Request weather update from phone
-static void request_weather_update() {
+// Log the counters of the hour that just ended; parsed by tools/benchmark/timeline.py
+static void benchmark_report_hour(int hour) {
+  APP_LOG(APP_LOG_LEVEL_INFO, "BENCH hour=%d in=%d in_bytes=%d out=%d out_bytes=%d persist=%d redraws=%d heap=%d",
+          hour, s_bench.messages_in, (int)s_bench.bytes_in, s_bench.messages_out, (int)s_bench.bytes_out,
+          s_bench.persist_writes, s_bench.redraws, (int)s_bench.heap_used_max);
+  s_bench = (BenchmarkCounters) { 0 };
+}
+#endif
+
+// Phone connection changes: requests are suspended while disconnected and one
+// catch-up request for everything due goes out on reconnect
+static void app_connection_handler(bool connected) {
+  s_phone_connected = connected;
+  log_event(EVENT_CONNECTION, connected);
+  update_weather_display();  // Offline indicator
+
+  if (connected) {
+    s_last_request_time = 0;  // Don't wait out the request spacing
+    uint8_t due_groups = get_due_groups(time(NULL));
+    if (due_groups) {
+      request_weather_update(due_groups);  // Carries the resume point of an open transfer
+    } else if (s_transfer.id && s_transfer.received < s_transfer.count) {
+      DictionaryIterator *iter;
+      if (app_message_outbox_begin(&iter) == APP_MSG_OK && iter != NULL) {
+        write_transfer_ack(iter);
+        app_message_outbox_send();
+      }
+    }
+  }
+}
+
+// Request an update of the given data groups (GROUP_BIT mask) from the phone
+static void request_weather_update(uint8_t groups) {
   DictionaryIterator *iter;
-  app_message_outbox_begin(&iter);
+  if (app_message_outbox_begin(&iter) != APP_MSG_OK || iter == NULL) {
+    LOG_WARNING("Update request not sent: outbox busy");
+    return;  // Still due, so a later tick retries
+  }
 
-  if (iter == NULL) {
+  // Tell the phone which subsystems this build has so it skips the rest, and
+  // the power profile so it can drop sources and its own background syncs
+  dict_write_uint8(iter, MESSAGE_KEY_WATCH_FEATURES, WATCH_FEATURES);
+  dict_write_uint8(iter, MESSAGE_KEY_POWER_PROFILE, s_power_profile);
+  dict_write_uint8(iter, MESSAGE_KEY_REFRESH_SOURCES, groups);
+  dict_write_uint16(iter, MESSAGE_KEY_INBOX_SIZE, s_inbox_size);
+  dict_write_uint16(iter, MESSAGE_KEY_TRANSFER_CAPACITY, TRANSFER_BUFFER_SIZE);
+#ifdef FITZFACE_BENCHMARK_ENDPOINT
+  // Local stand-in for every provider (tools/benchmark/timeline.py)
+  dict_write_cstring(iter, MESSAGE_KEY_BENCHMARK_ENDPOINT, FITZFACE_BENCHMARK_ENDPOINT);
+#endif
+  if (s_transfer.id && s_transfer.received < s_transfer.count) {
+    write_transfer_ack(iter);  // Resume the interrupted transfer before anything new
+  }
+  if (app_message_outbox_send() != APP_MSG_OK) {
+    LOG_WARNING("Update request not sent");
     return;
   }
+  log_event(EVENT_REQUEST, groups);
+  s_last_request_time = time(NULL);
+}
 
-  dict_write_uint8(iter, 0, 0); // Dummy message to trigger JS
-  app_message_outbox_send();
+// Little-endian integers in phone-packed byte arrays
+static uint32_t read_uint32_le(const uint8_t *data) {
+  return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
 }
 
-// Load persisted weather data
-static void load_persisted_data() {
-  if (persist_exists(PERSIST_KEY_TEMPERATURE)) {
-    s_weather_data.temperature = persist_read_int(PERSIST_KEY_TEMPERATURE);
-    s_weather_data.wind_speed = persist_read_int(PERSIST_KEY_WIND_SPEED);
-    s_weather_data.uv_index = persist_read_int(PERSIST_KEY_UV_INDEX);
-    s_weather_data.weather_code = persist_read_int(PERSIST_KEY_WEATHER_CODE);
-    s_weather_data.weather_code_tomorrow = persist_read_int(PERSIST_KEY_WEATHER_CODE_TOMORROW);
-    s_weather_data.aqi = persist_read_int(PERSIST_KEY_AQI);
-    s_weather_data.temp_max = persist_read_int(PERSIST_KEY_TEMP_MAX);
-    s_weather_data.temp_min = persist_read_int(PERSIST_KEY_TEMP_MIN);
-    s_weather_data.tide_time = persist_read_int(PERSIST_KEY_TIDE_TIME);
-    s_weather_data.tide_type = persist_read_int(PERSIST_KEY_TIDE_TYPE);
-    s_weather_data.sunrise = persist_read_int(PERSIST_KEY_SUNRISE);
-    s_weather_data.sunset = persist_read_int(PERSIST_KEY_SUNSET);
-
-    if (persist_exists(PERSIST_KEY_LOCATION)) {
-      persist_read_string(PERSIST_KEY_LOCATION, s_weather_data.location, sizeof(s_weather_data.location));
+static uint16_t read_uint16_le(const uint8_t *data) {
+  return data[0] | (data[1] << 8);
+}
+
+#if FEATURE_MUNI
+// Unpack the MUNI_TABLE byte array (layout documented in packMuniTable() in index.js)
+static void unpack_muni_table(const Tuple *tuple) {
+  const uint8_t *data = tuple->value->data;
+  uint16_t length = tuple->length;
+  s_weather_data.muni_route_count = 0;
+  if (length < MUNI_TABLE_HEADER_SIZE) {
+    return;
+  }
+
+  time_t base = (time_t)read_uint32_le(data);
+  int count = data[4];
+  if (count > MUNI_MAX_ROUTES) {
+    count = MUNI_MAX_ROUTES;
+  }
+
+  for (int r = 0; r < count; r++) {
+    const uint8_t *entry = data + MUNI_TABLE_HEADER_SIZE + r * MUNI_TABLE_ROUTE_SIZE;
+    if (entry + MUNI_TABLE_ROUTE_SIZE > data + length) {
+      break;
     }
 
-    if (persist_exists(PERSIST_KEY_ALERT_TEXT)) {
-      persist_read_string(PERSIST_KEY_ALERT_TEXT, s_weather_data.alert_text, sizeof(s_weather_data.alert_text));
+    MuniRoute *route = &s_weather_data.muni_routes[r];
+    memcpy(route->label, entry, 4);
+    route->label[4] = '\0';
+    route->scheduled = (route->label[0] & MUNI_ROUTE_SCHEDULED) != 0;
+    route->label[0] &= ~MUNI_ROUTE_SCHEDULED;
+    for (int i = 0; i < MUNI_MAX_ARRIVALS; i++) {
+      uint16_t offset = read_uint16_le(entry + 4 + i * 2);
+      route->arrivals[i] = offset ? base + offset : 0;
     }
+    s_weather_data.muni_route_count = r + 1;
+  }
+}
+#endif
+
+// Unpack the PRECIP_HOURLY byte array (layout documented in packPrecipHourly() in index.js)
+static void unpack_precip_hourly(const Tuple *tuple) {
+  PrecipForecast *forecast = &s_weather_data.precip_hourly;
+  memset(forecast, 0, sizeof(*forecast));
+  if (tuple->length < PRECIP_HOURLY_HEADER_SIZE) {
+    return;
+  }
+
+  int hours = tuple->length - PRECIP_HOURLY_HEADER_SIZE;
+  if (hours > PRECIP_HOURS) {
+    hours = PRECIP_HOURS;
+  }
+  memcpy(forecast->chance, tuple->value->data + PRECIP_HOURLY_HEADER_SIZE, hours);
+  forecast->start = hours > 0 ? (time_t)read_uint32_le(tuple->value->data) : 0;
+}
 
-    if (persist_exists(PERSIST_KEY_ALERT_ACTIVE)) {
-      s_weather_data.alert_active = persist_read_bool(PERSIST_KEY_ALERT_ACTIVE);
+// Unpack the NOWCAST byte array (layout documented in packNowcast() in index.js)
+static void unpack_nowcast(const Tuple *tuple) {
+  Nowcast *nowcast = &s_weather_data.nowcast;
+  memset(nowcast, 0, sizeof(*nowcast));
+  if (tuple->length < NOWCAST_HEADER_SIZE) {
+    return;
+  }
+
+  int count = tuple->value->data[4];
+  int available = (tuple->length - NOWCAST_HEADER_SIZE) * 4;
+  if (count > available) {
+    count = available;
+  }
+  if (count > NOWCAST_SLOTS) {
+    count = NOWCAST_SLOTS;
+  }
+  memcpy(nowcast->levels, tuple->value->data + NOWCAST_HEADER_SIZE, (count + 3) / 4);
+  nowcast->count = count;
+  nowcast->start = count > 0 ? (time_t)read_uint32_le(tuple->value->data) : 0;
+}
+
+#if FEATURE_TIDE
+// Unpack the TIDE_TABLE byte array (layout documented in packTideTable() in index.js)
+static void unpack_tide_table(const Tuple *tuple) {
+  const uint8_t *data = tuple->value->data;
+  TideTable *table = &s_weather_data.tide_table;
+  table->count = 0;
+  if (tuple->length < TIDE_TABLE_HEADER_SIZE) {
+    return;
+  }
+
+  time_t base = (time_t)read_uint32_le(data);
+  int count = data[4];
+  if (count > TIDE_TABLE_MAX) {
+    count = TIDE_TABLE_MAX;
+  }
+
+  for (int i = 0; i < count; i++) {
+    const uint8_t *entry = data + TIDE_TABLE_HEADER_SIZE + i * TIDE_TABLE_ENTRY_SIZE;
+    if (entry + TIDE_TABLE_ENTRY_SIZE > data + tuple->length) {
+      break;
     }
 
-    // Load MUNI timestamps
-    for (int i = 0; i < 6; i++) {
-      int persist_key = PERSIST_KEY_MUNI_TIMESTAMP_1 + i;
-      // Skip indices 2-5 since they use non-sequential keys
-      if (i == 2) persist_key = PERSIST_KEY_MUNI_TIMESTAMP_3;
-      else if (i == 3) persist_key = PERSIST_KEY_MUNI_TIMESTAMP_4;
-      else if (i == 4) persist_key = PERSIST_KEY_MUNI_TIMESTAMP_5;
-      else if (i == 5) persist_key = PERSIST_KEY_MUNI_TIMESTAMP_6;
-
-      s_weather_data.muni_timestamps[i] = persist_exists(persist_key) ?
-                                           persist_read_int(persist_key) : 0;
+    TideExtreme *extreme = &table->extremes[i];
+    extreme->time = base + read_uint16_le(entry) * 60;
+    extreme->type = entry[2];
+    extreme->height = (int16_t)read_uint16_le(entry + 3);
+    table->count = i + 1;
+  }
+}
+#endif
+
+// Validate a day table header (layout documented in packDayTableHeader() in index.js).
+// Returns the number of complete days in the array and sets *start.
+static int read_day_table_header(const Tuple *tuple, int day_size, time_t *start) {
+  if (tuple->length < DAY_TABLE_HEADER_SIZE) {
+    *start = 0;
+    return 0;
+  }
+
+  int count = tuple->value->data[4];
+  int available = (tuple->length - DAY_TABLE_HEADER_SIZE) / day_size;
+  if (count > available) {
+    count = available;
+  }
+  if (count > FORECAST_DAYS) {
+    count = FORECAST_DAYS;
+  }
+  *start = count > 0 ? (time_t)read_uint32_le(tuple->value->data) : 0;
+  return count;
+}
+
+// Unpack the DAILY_WEATHER byte array (layout documented in packDailyWeather() in index.js)
+static void unpack_daily_weather(const Tuple *tuple) {
+  DailyWeatherTable *table = &s_weather_data.daily_weather;
+  table->count = read_day_table_header(tuple, DAILY_WEATHER_DAY_SIZE, &table->start);
+  for (int i = 0; i < table->count; i++) {
+    const uint8_t *entry = tuple->value->data + DAY_TABLE_HEADER_SIZE + i * DAILY_WEATHER_DAY_SIZE;
+    DailyWeather *day = &table->days[i];
+    day->weather_code = entry[0];
+    day->temp_min = (int16_t)read_uint16_le(entry + 1);
+    day->temp_max = (int16_t)read_uint16_le(entry + 3);
+    day->precip_max = entry[5];
+    day->uv_max = entry[6];
+  }
+  shift_daily_forecast();  // The phone's first day may already be over
+}
+
+#if FEATURE_POLLEN
+// Unpack the DAILY_POLLEN byte array (layout documented in packDailyPollen() in index.js)
+static void unpack_daily_pollen(const Tuple *tuple) {
+  DailyPollenTable *table = &s_weather_data.daily_pollen;
+  table->count = read_day_table_header(tuple, DAILY_POLLEN_DAY_SIZE, &table->start);
+  for (int i = 0; i < table->count; i++) {
+    const uint8_t *entry = tuple->value->data + DAY_TABLE_HEADER_SIZE + i * DAILY_POLLEN_DAY_SIZE;
+    DailyPollen *day = &table->days[i];
+    day->tree = (int8_t)entry[0];
+    day->grass = (int8_t)entry[1];
+    day->weed = (int8_t)entry[2];
+  }
+  shift_daily_forecast();
+}
+#endif
+
+// Address of a schema field in s_weather_data or s_config
+static void *message_field_value(const MessageField *field) {
+  uint8_t *base = field->target == FIELD_TARGET_CONFIG ? (uint8_t *)&s_config : (uint8_t *)&s_weather_data;
+  return base + field->offset;
+}
+
+// Whether the SDK numbered message keys consecutively in messageKeys order,
+// which lets find_message_field() index s_message_slots directly
+static bool s_message_slots_valid;
+
+static void validate_message_slots() {
+  s_message_slots_valid = true;
+  for (int i = 0; i < MESSAGE_FIELD_COUNT; i++) {
+    uint32_t slot = *s_message_schema[i].key - MESSAGE_SCHEMA_FIRST_KEY;
+    if (slot >= MESSAGE_SCHEMA_KEY_COUNT || s_message_slots[slot] != i + 1) {
+      LOG_WARNING("Message keys not sequential, using schema scan");
+      log_event(EVENT_SCHEMA_SCAN, 0);
+      s_message_slots_valid = false;
+      return;
+    }
+  }
+}
+
+// Schema entry for a message key (NULL = key not decoded by the watch)
+static const MessageField *find_message_field(uint32_t key) {
+  if (s_message_slots_valid) {
+    uint32_t slot = key - MESSAGE_SCHEMA_FIRST_KEY;
+    if (slot >= MESSAGE_SCHEMA_KEY_COUNT || s_message_slots[slot] == 0) {
+      return NULL;
     }
+    return &s_message_schema[s_message_slots[slot] - 1];
+  }
 
-    // Load pollen data
-    s_weather_data.pollen_tree = persist_exists(PERSIST_KEY_POLLEN_TREE) ?
-                                  persist_read_int(PERSIST_KEY_POLLEN_TREE) : -1;
-    s_weather_data.pollen_grass = persist_exists(PERSIST_KEY_POLLEN_GRASS) ?
-                                   persist_read_int(PERSIST_KEY_POLLEN_GRASS) : -1;
-    s_weather_data.pollen_weed = persist_exists(PERSIST_KEY_POLLEN_WEED) ?
-                                  persist_read_int(PERSIST_KEY_POLLEN_WEED) : -1;
-    s_weather_data.precipitation_probability = persist_exists(PERSIST_KEY_PRECIPITATION_PROBABILITY) ?
-                                                persist_read_int(PERSIST_KEY_PRECIPITATION_PROBABILITY) : 0;
-  } else {
-    // Default values
-    s_weather_data.temperature = 0;
-    s_weather_data.wind_speed = 0;
-    s_weather_data.uv_index = 0;
-    s_weather_data.weather_code = 0;
-    s_weather_data.aqi = 0;
-    s_weather_data.temp_max = 0;
-    s_weather_data.temp_min = 0;
-    s_weather_data.tide_time = 0;
-    s_weather_data.tide_type = 0;
-    s_weather_data.sunrise = 0;
-    s_weather_data.sunset = 0;
-    for (int i = 0; i < 6; i++) {
-      s_weather_data.muni_timestamps[i] = 0;  // No MUNI data
+  for (int i = 0; i < MESSAGE_FIELD_COUNT; i++) {
+    if (*s_message_schema[i].key == key) {
+      return &s_message_schema[i];
     }
-    s_weather_data.pollen_tree = -1;   // No pollen data
-    s_weather_data.pollen_grass = -1;
-    s_weather_data.pollen_weed = -1;
-    snprintf(s_weather_data.location, sizeof(s_weather_data.location), "Loading...");
-  }
-}
-
-// Save weather data to persistent storage
-static void save_weather_data() {
-  persist_write_int(PERSIST_KEY_TEMPERATURE, s_weather_data.temperature);
-  persist_write_int(PERSIST_KEY_WIND_SPEED, s_weather_data.wind_speed);
-  persist_write_int(PERSIST_KEY_UV_INDEX, s_weather_data.uv_index);
-  persist_write_int(PERSIST_KEY_WEATHER_CODE, s_weather_data.weather_code);
-  persist_write_int(PERSIST_KEY_WEATHER_CODE_TOMORROW, s_weather_data.weather_code_tomorrow);
-  persist_write_int(PERSIST_KEY_AQI, s_weather_data.aqi);
-  persist_write_int(PERSIST_KEY_TEMP_MAX, s_weather_data.temp_max);
-  persist_write_int(PERSIST_KEY_TEMP_MIN, s_weather_data.temp_min);
-  persist_write_int(PERSIST_KEY_TIDE_TIME, s_weather_data.tide_time);
-  persist_write_int(PERSIST_KEY_TIDE_TYPE, s_weather_data.tide_type);
-  persist_write_int(PERSIST_KEY_SUNRISE, s_weather_data.sunrise);
-  persist_write_int(PERSIST_KEY_SUNSET, s_weather_data.sunset);
-  persist_write_string(PERSIST_KEY_LOCATION, s_weather_data.location);
-  persist_write_string(PERSIST_KEY_ALERT_TEXT, s_weather_data.alert_text);
-  persist_write_bool(PERSIST_KEY_ALERT_ACTIVE, s_weather_data.alert_active);
-
-  // Save MUNI timestamps
-  for (int i = 0; i < 6; i++) {
-    int persist_key = PERSIST_KEY_MUNI_TIMESTAMP_1 + i;
-    // Skip indices 2-5 since they use non-sequential keys
-    if (i == 2) persist_key = PERSIST_KEY_MUNI_TIMESTAMP_3;
-    else if (i == 3) persist_key = PERSIST_KEY_MUNI_TIMESTAMP_4;
-    else if (i == 4) persist_key = PERSIST_KEY_MUNI_TIMESTAMP_5;
-    else if (i == 5) persist_key = PERSIST_KEY_MUNI_TIMESTAMP_6;
-
-    persist_write_int(persist_key, s_weather_data.muni_timestamps[i]);
-  }
-
-  persist_write_int(PERSIST_KEY_POLLEN_TREE, s_weather_data.pollen_tree);
-  persist_write_int(PERSIST_KEY_POLLEN_GRASS, s_weather_data.pollen_grass);
-  persist_write_int(PERSIST_KEY_POLLEN_WEED, s_weather_data.pollen_weed);
-  persist_write_int(PERSIST_KEY_PRECIPITATION_PROBABILITY, s_weather_data.precipitation_probability);
+  }
+  return NULL;
 }
 
-// Load configuration
-static void load_config() {
-  s_config.temp_celsius = persist_exists(PERSIST_KEY_CONFIG_TEMP_UNIT) ?
-                          persist_read_bool(PERSIST_KEY_CONFIG_TEMP_UNIT) : false;
-  s_config.show_aqi = persist_exists(PERSIST_KEY_CONFIG_SHOW_AQI) ?
-                      persist_read_bool(PERSIST_KEY_CONFIG_SHOW_AQI) : true;
-  s_config.show_uv = persist_exists(PERSIST_KEY_CONFIG_SHOW_UV) ?
-                     persist_read_bool(PERSIST_KEY_CONFIG_SHOW_UV) : true;
-  s_config.show_wind = persist_exists(PERSIST_KEY_CONFIG_SHOW_WIND) ?
-                       persist_read_bool(PERSIST_KEY_CONFIG_SHOW_WIND) : true;
-  s_config.show_tide = persist_exists(PERSIST_KEY_CONFIG_SHOW_TIDE) ?
-                       persist_read_bool(PERSIST_KEY_CONFIG_SHOW_TIDE) : true;
-  s_config.show_sunrise = persist_exists(PERSIST_KEY_CONFIG_SHOW_SUNRISE) ?
-                          persist_read_bool(PERSIST_KEY_CONFIG_SHOW_SUNRISE) : true;
-  s_config.invert_colors = persist_exists(PERSIST_KEY_CONFIG_INVERT) ?
-                           persist_read_bool(PERSIST_KEY_CONFIG_INVERT) : false;
-}
-
-// Save configuration
-static void save_config() {
-  persist_write_bool(PERSIST_KEY_CONFIG_TEMP_UNIT, s_config.temp_celsius);
-  persist_write_bool(PERSIST_KEY_CONFIG_SHOW_AQI, s_config.show_aqi);
-  persist_write_bool(PERSIST_KEY_CONFIG_SHOW_UV, s_config.show_uv);
-  persist_write_bool(PERSIST_KEY_CONFIG_SHOW_WIND, s_config.show_wind);
-  persist_write_bool(PERSIST_KEY_CONFIG_SHOW_TIDE, s_config.show_tide);
-  persist_write_bool(PERSIST_KEY_CONFIG_SHOW_SUNRISE, s_config.show_sunrise);
-  persist_write_bool(PERSIST_KEY_CONFIG_INVERT, s_config.invert_colors);
+// Write a field to its persist slot
+static void persist_message_field(const MessageField *field) {
+  const void *value = message_field_value(field);
+  switch (field->type) {
+    case FIELD_INT:
+      persist_write_int(field->persist_key, *(const int *)value);
+      break;
+    case FIELD_TIME:
+    case FIELD_TIMESTAMP:
+      persist_write_int(field->persist_key, *(const time_t *)value);
+      break;
+    case FIELD_BOOL:
+      persist_write_bool(field->persist_key, *(const bool *)value);
+      break;
+    case FIELD_STRING:
+      persist_write_string(field->persist_key, (const char *)value);
+      break;
+    default:
+      break;
+  }
 }
 
-// AppMessage inbox received callback
-static void inbox_received_callback(DictionaryIterator *iterator, void *context) {
-  // Read weather data
-  Tuple *temp_tuple = dict_find(iterator, KEY_TEMPERATURE);
-  Tuple *wind_tuple = dict_find(iterator, KEY_WIND_SPEED);
-  Tuple *uv_tuple = dict_find(iterator, KEY_UV_INDEX);
-  Tuple *weather_code_tuple = dict_find(iterator, KEY_WEATHER_CODE);
-  Tuple *weather_code_tomorrow_tuple = dict_find(iterator, KEY_WEATHER_CODE_TOMORROW);
-  Tuple *aqi_tuple = dict_find(iterator, KEY_AQI);
-  Tuple *precip_prob_tuple = dict_find(iterator, KEY_PRECIPITATION_PROBABILITY);
-  Tuple *temp_max_tuple = dict_find(iterator, KEY_TEMP_MAX);
-  Tuple *temp_min_tuple = dict_find(iterator, KEY_TEMP_MIN);
-  Tuple *tide_time_tuple = dict_find(iterator, KEY_TIDE_NEXT_TIME);
-  Tuple *tide_type_tuple = dict_find(iterator, KEY_TIDE_NEXT_TYPE);
-  Tuple *sunrise_tuple = dict_find(iterator, KEY_SUNRISE);
-  Tuple *sunset_tuple = dict_find(iterator, KEY_SUNSET);
-  Tuple *location_tuple = dict_find(iterator, KEY_LOCATION_NAME);
-  Tuple *alert_text_tuple = dict_find(iterator, KEY_ALERT_TEXT);
-  Tuple *alert_active_tuple = dict_find(iterator, KEY_ALERT_ACTIVE);
-  Tuple *muni_timestamp_1_tuple = dict_find(iterator, KEY_MUNI_TIMESTAMP_1);
-  Tuple *muni_timestamp_2_tuple = dict_find(iterator, KEY_MUNI_TIMESTAMP_2);
-  Tuple *muni_timestamp_3_tuple = dict_find(iterator, KEY_MUNI_TIMESTAMP_3);
-  Tuple *muni_timestamp_4_tuple = dict_find(iterator, KEY_MUNI_TIMESTAMP_4);
-  Tuple *muni_timestamp_5_tuple = dict_find(iterator, KEY_MUNI_TIMESTAMP_5);
-  Tuple *muni_timestamp_6_tuple = dict_find(iterator, KEY_MUNI_TIMESTAMP_6);
-  Tuple *pollen_tree_tuple = dict_find(iterator, KEY_POLLEN_TREE);
-  Tuple *pollen_grass_tuple = dict_find(iterator, KEY_POLLEN_GRASS);
-  Tuple *pollen_weed_tuple = dict_find(iterator, KEY_POLLEN_WEED);
-
-  // Read configuration
-  Tuple *temp_unit_tuple = dict_find(iterator, KEY_CONFIG_TEMP_UNIT);
-  Tuple *show_aqi_tuple = dict_find(iterator, KEY_CONFIG_SHOW_AQI);
-  Tuple *show_uv_tuple = dict_find(iterator, KEY_CONFIG_SHOW_UV);
-  Tuple *show_wind_tuple = dict_find(iterator, KEY_CONFIG_SHOW_WIND);
-  Tuple *show_tide_tuple = dict_find(iterator, KEY_CONFIG_SHOW_TIDE);
-  Tuple *show_sunrise_tuple = dict_find(iterator, KEY_CONFIG_SHOW_SUNRISE);
-  Tuple *invert_tuple = dict_find(iterator, KEY_CONFIG_INVERT);
-
-  // Update weather data
-  if (temp_tuple) s_weather_data.temperature = (int)temp_tuple->value->int32;
-  if (wind_tuple) s_weather_data.wind_speed = (int)wind_tuple->value->int32;
-  if (uv_tuple) s_weather_data.uv_index = (int)uv_tuple->value->int32;
-  if (weather_code_tuple) s_weather_data.weather_code = (int)weather_code_tuple->value->int32;
-  if (weather_code_tomorrow_tuple) s_weather_data.weather_code_tomorrow = (int)weather_code_tomorrow_tuple->value->int32;
-  if (aqi_tuple) s_weather_data.aqi = (int)aqi_tuple->value->int32;
-  if (precip_prob_tuple) s_weather_data.precipitation_probability = (int)precip_prob_tuple->value->int32;
-  if (temp_max_tuple) s_weather_data.temp_max = (int)temp_max_tuple->value->int32;
-  if (temp_min_tuple) s_weather_data.temp_min = (int)temp_min_tuple->value->int32;
-  if (tide_time_tuple) s_weather_data.tide_time = (int)tide_time_tuple->value->int32;
-  if (tide_type_tuple) s_weather_data.tide_type = (int)tide_type_tuple->value->int32;
-  if (sunrise_tuple) s_weather_data.sunrise = (int)sunrise_tuple->value->int32;
-  if (sunset_tuple) s_weather_data.sunset = (int)sunset_tuple->value->int32;
-  if (location_tuple) {
-    snprintf(s_weather_data.location, sizeof(s_weather_data.location), "%s", location_tuple->value->cstring);
-  }
-
-  // Update MUNI timestamps
-  Tuple *muni_tuples[6] = {
-    muni_timestamp_1_tuple, muni_timestamp_2_tuple, muni_timestamp_3_tuple,
-    muni_timestamp_4_tuple, muni_timestamp_5_tuple, muni_timestamp_6_tuple
-  };
-  for (int i = 0; i < 6; i++) {
-    if (muni_tuples[i]) {
-      s_weather_data.muni_timestamps[i] = (time_t)muni_tuples[i]->value->int32;
+// Restore the persisted fields of a target (fields never stored keep their defaults)
+static void load_message_fields(FieldTarget target) {
+  for (int i = 0; i < MESSAGE_FIELD_COUNT; i++) {
+    const MessageField *field = &s_message_schema[i];
+    if (field->target != target || field->persist_key == 0 || !persist_exists(field->persist_key)) {
+      continue;
+    }
+
+    void *value = message_field_value(field);
+    switch (field->type) {
+      case FIELD_INT:
+        *(int *)value = persist_read_int(field->persist_key);
+        break;
+      case FIELD_TIME:
+      case FIELD_TIMESTAMP:
+        *(time_t *)value = persist_read_int(field->persist_key);
+        break;
+      case FIELD_BOOL:
+        *(bool *)value = persist_read_bool(field->persist_key);
+        break;
+      case FIELD_STRING:
+        persist_read_string(field->persist_key, (char *)value, field->size);
+        break;
+      default:
+        break;
     }
   }
+}
 
-  if (pollen_tree_tuple) s_weather_data.pollen_tree = (int)pollen_tree_tuple->value->int32;
-  if (pollen_grass_tuple) s_weather_data.pollen_grass = (int)pollen_grass_tuple->value->int32;
-  if (pollen_weed_tuple) s_weather_data.pollen_weed = (int)pollen_weed_tuple->value->int32;
+// Store one tuple in its field, persisting it when the value changed
+static void decode_message_field(const MessageField *field, const Tuple *tuple) {
+  void *value = message_field_value(field);
+  bool changed = false;
+
+  switch (field->type) {
+    case FIELD_INT: {
+      int decoded = (int)tuple->value->int32;
+      changed = *(int *)value != decoded;
+      *(int *)value = decoded;
+      break;
+    }
+    case FIELD_TIMESTAMP:
+      if (tuple->value->int32 <= 0) {
+        return;
+      }
+      // Fall through
+    case FIELD_TIME: {
+      time_t decoded = (time_t)tuple->value->int32;
+      changed = *(time_t *)value != decoded;
+      *(time_t *)value = decoded;
+      break;
+    }
+    case FIELD_BOOL: {
+      bool decoded = tuple->value->int32 != 0;
+      changed = *(bool *)value != decoded;
+      *(bool *)value = decoded;
+      break;
+    }
+    case FIELD_STRING:
+      changed = strncmp((char *)value, tuple->value->cstring, field->size - 1) != 0;
+      strncpy((char *)value, tuple->value->cstring, field->size - 1);
+      ((char *)value)[field->size - 1] = '\0';
+      break;
+    case FIELD_HANDLER:
+      field->handler(tuple);
+      return;
+  }
 
-  // Handle alert data
-  bool new_alert = false;
-  if (alert_text_tuple) {
-    snprintf(s_weather_data.alert_text, sizeof(s_weather_data.alert_text), "%s", alert_text_tuple->value->cstring);
+  if (field->persist_key && (changed || !persist_exists(field->persist_key))) {
+    persist_message_field(field);
   }
-  if (alert_active_tuple) {
-    bool was_active = s_weather_data.alert_active;
-    s_weather_data.alert_active = (bool)alert_active_tuple->value->int32;
-    // Trigger vibration if this is a new alert
-    if (s_weather_data.alert_active && !was_active) {
-      new_alert = true;
+}
+
+// Decode a message in a single pass over its tuples.
+// Returns a MESSAGE_FIELD_BIT() for every schema field the message contained.
+static uint64_t decode_message(DictionaryIterator *iterator) {
+  uint64_t received = 0;
+  for (Tuple *tuple = dict_read_first(iterator); tuple; tuple = dict_read_next(iterator)) {
+    const MessageField *field = find_message_field(tuple->key);
+    if (field) {
+      decode_message_field(field, tuple);
+      received |= (uint64_t)1 << (field - s_message_schema);
     }
   }
+  return received;
+}
 
-  // Update configuration
-  if (temp_unit_tuple) s_config.temp_celsius = (bool)temp_unit_tuple->value->int32;
-  if (show_aqi_tuple) s_config.show_aqi = (bool)show_aqi_tuple->value->int32;
-  if (show_uv_tuple) s_config.show_uv = (bool)show_uv_tuple->value->int32;
-  if (show_wind_tuple) s_config.show_wind = (bool)show_wind_tuple->value->int32;
-  if (show_tide_tuple) s_config.show_tide = (bool)show_tide_tuple->value->int32;
-  if (show_sunrise_tuple) s_config.show_sunrise = (bool)show_sunrise_tuple->value->int32;
-
-  // Handle color inversion setting change
-  if (invert_tuple) {
-    bool was_inverted = s_config.invert_colors;
-    s_config.invert_colors = (bool)invert_tuple->value->int32;
-    // Apply color theme if setting changed
-    if (was_inverted != s_config.invert_colors) {
-      apply_color_theme();
+// Load persisted weather data
+static void load_persisted_data() {
+  // Defaults for anything that has never been synced
+  snprintf(s_weather_data.location, sizeof(s_weather_data.location), "Loading...");
+
+  load_message_fields(FIELD_TARGET_WEATHER);
+
+  // Slots of removed fields (and those from before canonical units, which held
+  // display-unit values), deleted once on upgrade
+  if (persist_exists(PERSIST_KEY_LEGACY_TEMPERATURE)) {
+    static const uint32_t legacy_keys[] = {
+      PERSIST_KEY_LEGACY_TEMPERATURE, PERSIST_KEY_LEGACY_WIND_SPEED, PERSIST_KEY_LEGACY_TEMP_MAX,
+      PERSIST_KEY_LEGACY_TEMP_MIN, PERSIST_KEY_LEGACY_SUNRISE, PERSIST_KEY_LEGACY_SUNSET,
+      PERSIST_KEY_LEGACY_WEATHER_CODE_TOMORROW, PERSIST_KEY_LEGACY_MUNI_TIMESTAMP_1,
+      PERSIST_KEY_LEGACY_MUNI_TIMESTAMP_2, PERSIST_KEY_LEGACY_POLLEN_TREE, PERSIST_KEY_LEGACY_POLLEN_GRASS,
+      PERSIST_KEY_LEGACY_POLLEN_WEED, PERSIST_KEY_LEGACY_MUNI_TIMESTAMP_3, PERSIST_KEY_LEGACY_MUNI_TIMESTAMP_4,
+      PERSIST_KEY_LEGACY_MUNI_TIMESTAMP_5, PERSIST_KEY_LEGACY_MUNI_TIMESTAMP_6, PERSIST_KEY_LEGACY_DAILY_WEATHER,
+    };
+    for (size_t i = 0; i < ARRAY_LENGTH(legacy_keys); i++) {
+      persist_delete(legacy_keys[i]);
     }
   }
 
+  // Coordinates for the on-watch sunrise/sunset calculator
+  s_weather_data.has_coordinates = persist_exists(PERSIST_KEY_LATITUDE) && persist_exists(PERSIST_KEY_LONGITUDE);
+
+#if FEATURE_MUNI
+  // Load MUNI route table
+  if (persist_exists(PERSIST_KEY_MUNI_ROUTES) && persist_exists(PERSIST_KEY_MUNI_ROUTE_COUNT)) {
+    persist_read_data(PERSIST_KEY_MUNI_ROUTES, s_weather_data.muni_routes, sizeof(s_weather_data.muni_routes));
+    s_weather_data.muni_route_count = persist_read_int(PERSIST_KEY_MUNI_ROUTE_COUNT);
+  }
+#endif
+
+  // Load detail page forecasts
+  if (persist_exists(PERSIST_KEY_PRECIP_HOURLY)) {
+    persist_read_data(PERSIST_KEY_PRECIP_HOURLY, &s_weather_data.precip_hourly, sizeof(s_weather_data.precip_hourly));
+  }
+  if (persist_exists(PERSIST_KEY_NOWCAST)) {
+    persist_read_data(PERSIST_KEY_NOWCAST, &s_weather_data.nowcast, sizeof(s_weather_data.nowcast));
+  }
+#if FEATURE_TIDE
+  if (persist_exists(PERSIST_KEY_TIDE_TABLE)) {
+    persist_read_data(PERSIST_KEY_TIDE_TABLE, &s_weather_data.tide_table, sizeof(s_weather_data.tide_table));
+  }
+#endif
+
+  // Load the multi-day forecast and drop the days that passed while not running
+  if (persist_exists(PERSIST_KEY_DAILY_WEATHER)) {
+    persist_read_data(PERSIST_KEY_DAILY_WEATHER, &s_weather_data.daily_weather, sizeof(s_weather_data.daily_weather));
+  }
+#if FEATURE_POLLEN
+  if (persist_exists(PERSIST_KEY_DAILY_POLLEN)) {
+    persist_read_data(PERSIST_KEY_DAILY_POLLEN, &s_weather_data.daily_pollen, sizeof(s_weather_data.daily_pollen));
+  }
+#endif
+  shift_daily_forecast();
+
+  // Load per-group freshness timestamps
+  if (persist_exists(PERSIST_KEY_UPDATED)) {
+    persist_read_data(PERSIST_KEY_UPDATED, s_weather_data.updated, sizeof(s_weather_data.updated));
+  }
+
+  if (persist_exists(PERSIST_KEY_EVENT_LOG)) {
+    persist_read_data(PERSIST_KEY_EVENT_LOG, &s_event_log, sizeof(s_event_log));
+  }
+}
+
+// Save the state that schema fields don't persist themselves, each table only
+// when the sync carried it (received: MESSAGE_FIELD_BIT mask of the sync). The
+// event log is saved on exit.
+static void save_weather_data(uint64_t received) {
+#if FEATURE_MUNI
+  // Save MUNI route table
+  if (received & MESSAGE_FIELD_BIT(MUNI_TABLE)) {
+    persist_write_data(PERSIST_KEY_MUNI_ROUTES, s_weather_data.muni_routes, sizeof(s_weather_data.muni_routes));
+    persist_write_int(PERSIST_KEY_MUNI_ROUTE_COUNT, s_weather_data.muni_route_count);
+  }
+#endif
+  if (received & MESSAGE_FIELD_BIT(PRECIP_HOURLY)) {
+    persist_write_data(PERSIST_KEY_PRECIP_HOURLY, &s_weather_data.precip_hourly, sizeof(s_weather_data.precip_hourly));
+  }
+  if (received & MESSAGE_FIELD_BIT(NOWCAST)) {
+    persist_write_data(PERSIST_KEY_NOWCAST, &s_weather_data.nowcast, sizeof(s_weather_data.nowcast));
+  }
+#if FEATURE_TIDE
+  if (received & MESSAGE_FIELD_BIT(TIDE_TABLE)) {
+    persist_write_data(PERSIST_KEY_TIDE_TABLE, &s_weather_data.tide_table, sizeof(s_weather_data.tide_table));
+  }
+#endif
+  if (received & MESSAGE_FIELD_BIT(DAILY_WEATHER)) {
+    persist_write_data(PERSIST_KEY_DAILY_WEATHER, &s_weather_data.daily_weather, sizeof(s_weather_data.daily_weather));
+  }
+#if FEATURE_POLLEN
+  if (received & MESSAGE_FIELD_BIT(DAILY_POLLEN)) {
+    persist_write_data(PERSIST_KEY_DAILY_POLLEN, &s_weather_data.daily_pollen, sizeof(s_weather_data.daily_pollen));
+  }
+#endif
+  if (received & (MESSAGE_FIELD_BIT(UPDATED_WEATHER) | MESSAGE_FIELD_BIT(UPDATED_AQI) |
+                  MESSAGE_FIELD_BIT(UPDATED_TIDE) | MESSAGE_FIELD_BIT(UPDATED_MUNI) |
+                  MESSAGE_FIELD_BIT(UPDATED_POLLEN) | MESSAGE_FIELD_BIT(UPDATED_LOCATION) |
+                  MESSAGE_FIELD_BIT(UPDATED_DAILY))) {
+    persist_write_data(PERSIST_KEY_UPDATED, s_weather_data.updated, sizeof(s_weather_data.updated));
+  }
+}
+
+// Load configuration
+static void load_config() {
+  s_config.temp_celsius = false;
+  s_config.wind_unit = WIND_UNIT_MPH;
+  s_config.show_uv = true;
+  s_config.show_wind = true;
+  s_config.show_sunrise = true;
+#if FEATURE_AQI
+  s_config.show_aqi = true;
+#endif
+#if FEATURE_TIDE
+  s_config.show_tide = true;
+#endif
+#if FEATURE_INVERT
+  s_config.invert_colors = false;
+#endif
+  s_config.quiet_start = -1;
+  s_config.quiet_end = 7;
+  load_message_fields(FIELD_TARGET_CONFIG);
+}
+
+// Apply a sync, received directly or reassembled from a transfer
+static void apply_message(DictionaryIterator *iterator) {
+#if FEATURE_ALERTS
+  bool was_alert_active = s_weather_data.alert_active;
+#endif
+#if FEATURE_INVERT
+  bool was_inverted = s_config.invert_colors;
+#endif
+
+  uint64_t received = decode_message(iterator);
+  if (!(received & ~MESSAGE_FIELD_BIT(EVENT_LOG_REQUEST))) {
+    return;  // Event log request only (answered by the decoder) - nothing to save or redraw
+  }
+  log_event(EVENT_SYNC, __builtin_popcountll(received));
+
+  // Coordinates are only sent when they change - recompute sunrise/sunset
+  if ((received & MESSAGE_FIELD_BIT(LATITUDE)) && (received & MESSAGE_FIELD_BIT(LONGITUDE))) {
+    s_weather_data.has_coordinates = true;
+    update_sun_times();
+  }
+  s_freshness_state = get_freshness_state(time(NULL));
+
+#if FEATURE_INVERT
+  // Apply color theme if the setting changed
+  if (was_inverted != s_config.invert_colors) {
+    apply_color_theme();
+  }
+#endif
+
   // Save to persistent storage
-  save_weather_data();
-  save_config();
+  save_weather_data(received);
 
   // Update display
   update_weather_display();
+  update_shown_nowcast(nowcast_display_state(time(NULL)));
 
-  // Vibrate if new alert
-  if (new_alert) {
+#if FEATURE_ALERTS
+  // Vibrate if this is a new alert (unless the power profile silences vibrations)
+  if (s_weather_data.alert_active && !was_alert_active && s_power_profiles[s_power_profile].vibrate) {
     vibes_short_pulse();
   }
+#endif
+}
+
+// Acknowledge the current transfer: TRANSFER_ID and the number of chunks staged
+static void write_transfer_ack(DictionaryIterator *iter) {
+  dict_write_int32(iter, MESSAGE_KEY_TRANSFER_ID, s_transfer.id);
+  dict_write_uint8(iter, MESSAGE_KEY_TRANSFER_ACK, s_transfer.received);
+}
+
+static void send_transfer_ack() {
+  DictionaryIterator *iter;
+  if (app_message_outbox_begin(&iter) != APP_MSG_OK || iter == NULL) {
+    LOG_WARNING("Transfer ack not sent: outbox busy");
+    return;  // The phone's ack timeout resends the chunk
+  }
+  write_transfer_ack(iter);
+  app_message_outbox_send();
+}
+
+// Stage one chunk of a transfer and commit the dictionary once all chunks are in.
+// Chunks out of order (a resend of one already staged, or one past a gap) are
+// not staged; the ack tells the phone where to continue either way.
+static void receive_transfer_chunk(DictionaryIterator *iterator, const Tuple *data) {
+  Tuple *id_tuple = dict_find(iterator, MESSAGE_KEY_TRANSFER_ID);
+  Tuple *chunk_tuple = dict_find(iterator, MESSAGE_KEY_TRANSFER_CHUNK);
+  Tuple *count_tuple = dict_find(iterator, MESSAGE_KEY_TRANSFER_COUNT);
+  if (!id_tuple || !chunk_tuple || !count_tuple) {
+    return;
+  }
+
+  int32_t id = id_tuple->value->int32;
+  int chunk = chunk_tuple->value->int32;
+  if (id != s_transfer.id) {
+    // A new transfer replaces an unfinished one (the phone abandoned it)
+    s_transfer = (Transfer) { .id = id, .count = count_tuple->value->int32 };
+  }
+
+  if (chunk == s_transfer.received && s_transfer.received < s_transfer.count) {
+    if (chunk == 0) {
+      Tuple *size_tuple = dict_find(iterator, MESSAGE_KEY_TRANSFER_SIZE);
+      int size = size_tuple ? size_tuple->value->int32 : 0;
+      if (size <= 0 || size > TRANSFER_BUFFER_SIZE) {
+        LOG_ERROR("Transfer %d rejected: %d bytes", (int)id, size);
+        log_event(EVENT_TRANSFER, -1);
+        s_transfer.received = TRANSFER_REJECTED;  // The phone reports the sync as failed and stops sending
+        send_transfer_ack();
+        return;
+      }
+      s_transfer.size = size;
+    }
+    if (s_transfer.filled + data->length > s_transfer.size) {
+      LOG_ERROR("Transfer %d overflows at chunk %d", (int)id, chunk);
+      s_transfer = (Transfer) { 0 };
+      return;  // The phone times out and starts over with a new transfer
+    }
+    memcpy(s_transfer_buffer + s_transfer.filled, data->value->data, data->length);
+    s_transfer.filled += data->length;
+    s_transfer.received++;
+
+    if (s_transfer.received == s_transfer.count) {
+      if (s_transfer.filled == s_transfer.size) {
+        DictionaryIterator reassembled;
+        dict_read_begin_from_buffer(&reassembled, s_transfer_buffer, s_transfer.size);
+        log_event(EVENT_TRANSFER, s_transfer.count);
+        apply_message(&reassembled);
+      } else {
+        LOG_ERROR("Transfer %d short: %d of %d bytes", (int)id, s_transfer.filled, s_transfer.size);
+      }
+    }
+  }
+  send_transfer_ack();
+}
+
+// AppMessage inbox received callback
+static void inbox_received_callback(DictionaryIterator *iterator, void *context) {
+#ifdef FITZFACE_BENCHMARK
+  BENCH_COUNT(messages_in, 1);
+  BENCH_COUNT(bytes_in, benchmark_dict_size(iterator));
+  benchmark_sample_heap();
+#endif
+  Tuple *transfer_data = dict_find(iterator, MESSAGE_KEY_TRANSFER_DATA);
+  if (transfer_data) {
+    receive_transfer_chunk(iterator, transfer_data);
+  } else {
+    apply_message(iterator);
+  }
 }
 
 static void inbox_dropped_callback(AppMessageResult reason, void *context) {
-  APP_LOG(APP_LOG_LEVEL_ERROR, "Message dropped: %d", (int)reason);
+  LOG_ERROR("Message dropped: %d", (int)reason);
+  log_event(EVENT_INBOX_DROPPED, reason);
 }
 
 static void outbox_failed_callback(DictionaryIterator *iterator, AppMessageResult reason, void *context) {
-  APP_LOG(APP_LOG_LEVEL_ERROR, "Outbox send failed: %d", (int)reason);
+  LOG_ERROR("Outbox send failed: %d", (int)reason);
+  log_event(EVENT_OUTBOX_FAILED, reason);
 }
 
 static void outbox_sent_callback(DictionaryIterator *iterator, void *context) {
-  APP_LOG(APP_LOG_LEVEL_INFO, "Outbox send success!");
+  LOG_DEBUG("Outbox send success");
+#ifdef FITZFACE_BENCHMARK
+  BENCH_COUNT(messages_out, 1);
+  BENCH_COUNT(bytes_out, benchmark_dict_size(iterator));
+#endif
 }
 
 // Divider layer update proc - draws visual elements for depth
 static void divider_layer_update_proc(Layer *layer, GContext *ctx) {
   GRect bounds = layer_get_bounds(layer);
+  BENCH_COUNT(redraws, 1);  // The whole window renders on any change, this layer included
 
   // Draw header rectangle (adds depth) - inverts with theme
   graphics_context_set_fill_color(ctx, get_foreground_color());
@@ -794,9 +2159,18 @@ static void divider_layer_update_proc(Layer *layer, GContext *ctx) {
   graphics_draw_line(ctx, GPoint(0, 120), GPoint(bounds.size.w, 120)); // Before data row (120-144)
   graphics_draw_line(ctx, GPoint(0, 144), GPoint(bounds.size.w, 144)); // Before time row (144-168)
 
-  // Vertical dividers for 3-column grid (48px per column) - from grid start to bottom
-  graphics_draw_line(ctx, GPoint(48, 96), GPoint(48, bounds.size.h));  // Left divider
-  graphics_draw_line(ctx, GPoint(96, 96), GPoint(96, bounds.size.h));  // Right divider
+  // Vertical dividers per row (48px columns, or 72px when a feature's cell is compiled out)
+  static const struct { int16_t top; int16_t bottom; int8_t columns; } rows[] = {
+    { 96,  120, GRID_TEMP_COLUMNS },
+    { 120, 144, GRID_DATA_COLUMNS },
+    { 144, 168, GRID_TIME_COLUMNS },
+  };
+  for (unsigned int r = 0; r < ARRAY_LENGTH(rows); r++) {
+    for (int c = 1; c < rows[r].columns; c++) {
+      int x = grid_column_x(c, rows[r].columns, bounds.size.w);
+      graphics_draw_line(ctx, GPoint(x, rows[r].top), GPoint(x, rows[r].bottom));
+    }
+  }
 
   // Box around time area - tall enough to clear 42pt font
   graphics_context_set_stroke_color(ctx, get_foreground_color());
@@ -824,6 +2198,7 @@ static TextLayer* create_text_layer_colored(GRect frame, GTextAlignment alignmen
   return layer;
 }
 
+#if FEATURE_INVERT
 // Apply color theme - updates all UI elements when inversion changes
 static void apply_color_theme() {
   // Update window background
@@ -832,61 +2207,173 @@ static void apply_color_theme() {
   // Update all text layers
   text_layer_set_text_color(s_time_layer, get_foreground_color());
   text_layer_set_text_color(s_date_layer, get_foreground_color());
-  text_layer_set_text_color(s_alert_layer, get_foreground_color());
   text_layer_set_text_color(s_location_layer, get_background_color()); // Inverted for header
-  text_layer_set_text_color(s_muni_layer, get_foreground_color());
   text_layer_set_text_color(s_temp_min_layer, get_foreground_color());
   text_layer_set_text_color(s_temp_current_layer, get_foreground_color());
   text_layer_set_text_color(s_temp_max_layer, get_foreground_color());
   text_layer_set_text_color(s_wind_layer, get_foreground_color());
   text_layer_set_text_color(s_uv_layer, get_foreground_color());
-  text_layer_set_text_color(s_aqi_layer, get_foreground_color());
-  text_layer_set_text_color(s_tide_layer, get_foreground_color());
-  text_layer_set_text_color(s_pollen_layer, get_background_color());  // Inverted for header
   text_layer_set_text_color(s_precip_layer, get_background_color());  // Inverted for header
   text_layer_set_text_color(s_sunrise_layer, get_foreground_color());
   text_layer_set_text_color(s_sunset_layer, get_foreground_color());
+#if FEATURE_ALERTS
+  text_layer_set_text_color(s_alert_layer, get_foreground_color());
+#endif
+#if FEATURE_MUNI
+  text_layer_set_text_color(s_muni_layer, get_foreground_color());
+#endif
+#if FEATURE_AQI
+  text_layer_set_text_color(s_aqi_layer, get_foreground_color());
+#endif
+#if FEATURE_TIDE
+  text_layer_set_text_color(s_tide_layer, get_foreground_color());
+#endif
+#if FEATURE_POLLEN
+  text_layer_set_text_color(s_pollen_layer, get_background_color());  // Inverted for header
+#endif
 
-  // Reload weather icons with inverted versions
-  if (s_weather_icon) {
-    gbitmap_destroy(s_weather_icon);
-    uint32_t icon_resource = get_weather_icon_resource(s_weather_data.weather_code, true);
-    s_weather_icon = gbitmap_create_with_resource(icon_resource);
-    bitmap_layer_set_bitmap(s_weather_icon_layer, s_weather_icon);
-  }
-  if (s_weather_icon_tomorrow) {
-    gbitmap_destroy(s_weather_icon_tomorrow);
-    uint32_t icon_resource_tomorrow = get_weather_icon_resource(s_weather_data.weather_code_tomorrow, false);
-    s_weather_icon_tomorrow = gbitmap_create_with_resource(icon_resource_tomorrow);
-    bitmap_layer_set_bitmap(s_weather_icon_tomorrow_layer, s_weather_icon_tomorrow);
-  }
-
-  // Reload sunrise/sunset arrow bitmaps with inverted versions
-  if (s_arrow_up_bitmap) {
-    gbitmap_destroy(s_arrow_up_bitmap);
-    s_arrow_up_bitmap = gbitmap_create_with_resource(
-      s_config.invert_colors ? RESOURCE_ID_ARROW_UP_INVERTED : RESOURCE_ID_ARROW_UP
-    );
-    bitmap_layer_set_bitmap(s_arrow_up_layer, s_arrow_up_bitmap);
-  }
-  if (s_arrow_down_bitmap) {
-    gbitmap_destroy(s_arrow_down_bitmap);
-    s_arrow_down_bitmap = gbitmap_create_with_resource(
-      s_config.invert_colors ? RESOURCE_ID_ARROW_DOWN_INVERTED : RESOURCE_ID_ARROW_DOWN
-    );
-    bitmap_layer_set_bitmap(s_arrow_down_layer, s_arrow_down_bitmap);
-  }
-  if (s_wave_bitmap) {
-    gbitmap_destroy(s_wave_bitmap);
-    s_wave_bitmap = gbitmap_create_with_resource(
-      s_config.invert_colors ? RESOURCE_ID_WAVE_INVERTED : RESOURCE_ID_WAVE
-    );
-    bitmap_layer_set_bitmap(s_wave_layer, s_wave_bitmap);
-  }
+  // Icons keep their bitmaps; only the compositing op changes (no resource reloads)
+  bitmap_layer_set_compositing_mode(s_weather_icon_layer, get_bitmap_compositing_mode());
+  bitmap_layer_set_compositing_mode(s_weather_icon_tomorrow_layer, get_bitmap_compositing_mode());
+  bitmap_layer_set_compositing_mode(s_arrow_up_layer, get_bitmap_compositing_mode());
+  bitmap_layer_set_compositing_mode(s_arrow_down_layer, get_bitmap_compositing_mode());
+#if FEATURE_TIDE
+  bitmap_layer_set_compositing_mode(s_wave_layer, get_bitmap_compositing_mode());
+#endif
 
   // Force divider layer redraw (header and lines)
   layer_mark_dirty(s_divider_layer);
 }
+#endif
+
+// Detail page text: hourly precip, upcoming tides, every MUNI arrival, the pollen
+// breakdown and tomorrow's forecast, one line each. Worst case fits DETAIL_TEXT_SIZE.
+static int format_detail_text(char *buffer) {
+  time_t now = time(NULL);
+  int pos = 0;
+  buffer[0] = '\0';
+
+  const PrecipForecast *forecast = &s_weather_data.precip_hourly;
+  if (forecast->start && !is_group_expired(DATA_GROUP_WEATHER)) {
+    int first = now > forecast->start ? (now - forecast->start) / 3600 : 0;
+    if (first < PRECIP_HOURS) {
+      pos += format_str(buffer + pos, "Rain%");
+      for (int i = first; i < PRECIP_HOURS; i++) {
+        buffer[pos++] = ' ';
+        pos += format_uint(buffer + pos, forecast->chance[i]);
+      }
+      buffer[pos++] = '\n';
+    }
+  }
+
+#if FEATURE_TIDE
+  if (s_config.show_tide && !is_group_expired(DATA_GROUP_TIDE)) {
+    const TideTable *table = &s_weather_data.tide_table;
+    for (int i = 0; i < table->count; i++) {
+      if (table->extremes[i].time <= now) {
+        continue;
+      }
+      struct tm *tide_time = localtime(&table->extremes[i].time);
+      pos += format_str(buffer + pos, table->extremes[i].type ? "High " : "Low ");
+      pos += format_hhmm(buffer + pos, tide_time->tm_hour, tide_time->tm_min, true);
+      buffer[pos++] = ' ';
+      pos += format_tenths(buffer + pos, table->extremes[i].height);
+      pos += format_str(buffer + pos, "ft\n");
+    }
+  }
+#endif
+
+#if FEATURE_MUNI
+  if (!is_group_expired(DATA_GROUP_MUNI)) {
+    for (int r = 0; r < s_weather_data.muni_route_count; r++) {
+      int minutes[MUNI_MAX_ARRIVALS];
+      int count = get_muni_future_minutes(&s_weather_data.muni_routes[r], now, minutes, MUNI_MAX_ARRIVALS);
+      if (count > 0) {
+        pos += format_str(buffer + pos, s_weather_data.muni_routes[r].label);
+        pos += format_str(buffer + pos, s_weather_data.muni_routes[r].scheduled ? "* " : " ");
+        pos += format_minute_list(buffer + pos, minutes, count, " ");
+        buffer[pos++] = '\n';
+      }
+    }
+  }
+#endif
+
+#if FEATURE_POLLEN
+  const DailyPollen *pollen = get_daily_pollen(0);
+  if (pollen && !is_group_expired(DATA_GROUP_POLLEN)) {
+    pos += format_str(buffer + pos, "Tree ");
+    pos += format_int(buffer + pos, pollen->tree);
+    pos += format_str(buffer + pos, " Grass ");
+    pos += format_int(buffer + pos, pollen->grass);
+    pos += format_str(buffer + pos, " Weed ");
+    pos += format_int(buffer + pos, pollen->weed);
+    buffer[pos++] = '\n';
+  }
+#endif
+
+  const DailyWeather *tomorrow = get_daily_weather(1);
+  if (tomorrow) {
+    pos += format_str(buffer + pos, "Tmrw ");
+    pos += format_int(buffer + pos, display_temperature(tomorrow->temp_min));
+    buffer[pos++] = '|';
+    pos += format_int(buffer + pos, display_temperature(tomorrow->temp_max));
+    pos += format_str(buffer + pos, " Rain ");
+    pos += format_uint(buffer + pos, tomorrow->precip_max);
+    pos += format_str(buffer + pos, "% UV");
+    pos += format_uint(buffer + pos, tomorrow->uv_max);
+    buffer[pos++] = '\n';
+  }
+
+  if (pos == 0) {
+    pos = format_str(buffer, "No details yet");
+  } else {
+    buffer[--pos] = '\0';  // Drop the trailing newline
+  }
+  return pos;
+}
+
+static void hide_detail_page(void *context) {
+  s_detail_timer = NULL;
+  if (!s_detail_layer) {
+    return;
+  }
+  layer_remove_from_parent(text_layer_get_layer(s_detail_layer));
+  text_layer_destroy(s_detail_layer);
+  s_detail_layer = NULL;
+  free(s_detail_text);
+  s_detail_text = NULL;
+}
+
+static void show_detail_page() {
+  s_detail_text = malloc(DETAIL_TEXT_SIZE);
+  if (!s_detail_text) {
+    return;
+  }
+  format_detail_text(s_detail_text);
+
+  Layer *window_layer = window_get_root_layer(s_main_window);
+  s_detail_layer = create_text_layer_colored(layer_get_bounds(window_layer), GTextAlignmentCenter,
+                                             fonts_get_system_font(FONT_KEY_GOTHIC_14),
+                                             get_foreground_color(), get_background_color());
+  if (!s_detail_layer) {
+    free(s_detail_text);
+    s_detail_text = NULL;
+    return;
+  }
+  text_layer_set_text(s_detail_layer, s_detail_text);
+  layer_add_child(window_layer, text_layer_get_layer(s_detail_layer));
+  s_detail_timer = app_timer_register(DETAIL_PAGE_TIMEOUT_MS, hide_detail_page, NULL);
+}
+
+// Wrist tap toggles the detail page
+static void accel_tap_handler(AccelAxisType axis, int32_t direction) {
+  if (s_detail_layer) {
+    app_timer_cancel(s_detail_timer);
+    hide_detail_page(NULL);
+  } else {
+    show_detail_page();
+  }
+}
 
 // Window load handler
 static void main_window_load(Window *window) {
@@ -960,6 +2447,7 @@ static void main_window_load(Window *window) {
   );
   layer_add_child(window_layer, text_layer_get_layer(s_time_layer));
 
+#if FEATURE_POLLEN
   // Pollen display (top right corner, next to city name) - inverted colors for black header
   s_pollen_layer = create_text_layer_colored(
     GRect(110, 3, 30, 14),
@@ -970,7 +2458,9 @@ static void main_window_load(Window *window) {
   );
   layer_add_child(window_layer, text_layer_get_layer(s_pollen_layer));
   text_layer_set_text(s_pollen_layer, "");  // Empty by default
+#endif
 
+#if FEATURE_ALERTS
   // === ALERT SECTION (80-96, only shown when active) ===
   s_alert_layer = create_text_layer(
     GRect(0, 80, bounds.size.w, 16),
@@ -979,7 +2469,9 @@ static void main_window_load(Window *window) {
   );
   layer_add_child(window_layer, text_layer_get_layer(s_alert_layer));
   layer_set_hidden(text_layer_get_layer(s_alert_layer), !s_alert_active);
+#endif
 
+#if FEATURE_MUNI
   // === MUNI BUS COUNTDOWN (Top-left grid cell: 0-48, 98-120) ===
   s_muni_layer = create_text_layer(
     GRect(-2, 96, 60, 20),
@@ -988,6 +2480,7 @@ static void main_window_load(Window *window) {
   );
   layer_add_child(window_layer, text_layer_get_layer(s_muni_layer));
   text_layer_set_text(s_muni_layer, ":)");  // Default placeholder
+#endif
 
   // === TEMPERATURE GRID (Row 1: 96-120, 24px boxes anchored to bottom) ===
   // Low temp - unused (combined with high in s_temp_max_layer)
@@ -1000,8 +2493,9 @@ static void main_window_load(Window *window) {
   layer_set_hidden(text_layer_get_layer(s_temp_min_layer), true);
 
   // Current - Middle column (48-96) - centered in full 48px box, shifted right 4px, up 2px
+  int temp_width = bounds.size.w / GRID_TEMP_COLUMNS;
   s_temp_current_layer = create_text_layer(
-    GRect(52, 96, 48, 20),
+    GRect(grid_column_x(GRID_TEMP_COLUMNS - 2, GRID_TEMP_COLUMNS, bounds.size.w) + 4, 96, temp_width, 20),
     GTextAlignmentCenter,
     fonts_get_system_font(FONT_KEY_GOTHIC_18)
   );
@@ -1009,7 +2503,7 @@ static void main_window_load(Window *window) {
 
   // High/Low combined - Right column (96-144) - format: "53°|59°" centered
   s_temp_max_layer = create_text_layer(
-    GRect(96, 100, 48, 20),
+    GRect(grid_column_x(GRID_TEMP_COLUMNS - 1, GRID_TEMP_COLUMNS, bounds.size.w), 100, temp_width, 20),
     GTextAlignmentCenter,
     fonts_get_system_font(FONT_KEY_GOTHIC_14)
   );
@@ -1023,8 +2517,9 @@ static void main_window_load(Window *window) {
 
   // === DATA GRID (Row 2: 120-144, 24px boxes anchored to bottom) ===
   // Wind - Left column (0-48) - centered in 24px box
+  int data_width = bounds.size.w / GRID_DATA_COLUMNS;
   s_wind_layer = create_text_layer(
-    GRect(0, 122, 48, 20),
+    GRect(0, 122, data_width, 20),
     GTextAlignmentCenter,
     fonts_get_system_font(FONT_KEY_GOTHIC_18)
   );
@@ -1032,21 +2527,30 @@ static void main_window_load(Window *window) {
 
   // UV - Middle column (48-96) - centered in 24px box
   s_uv_layer = create_text_layer(
-    GRect(48, 122, 48, 20),
+    GRect(grid_column_x(1, GRID_DATA_COLUMNS, bounds.size.w), 122, data_width, 20),
     GTextAlignmentCenter,
     fonts_get_system_font(FONT_KEY_GOTHIC_18)
   );
   layer_add_child(window_layer, text_layer_get_layer(s_uv_layer));
 
+#if FEATURE_AQI
   // AQI - Right column (96-144) - centered in 24px box
   s_aqi_layer = create_text_layer(
-    GRect(96, 122, 48, 20),
+    GRect(grid_column_x(2, GRID_DATA_COLUMNS, bounds.size.w), 122, data_width, 20),
     GTextAlignmentCenter,
     fonts_get_system_font(FONT_KEY_GOTHIC_18)
   );
   layer_add_child(window_layer, text_layer_get_layer(s_aqi_layer));
+#endif
 
   // === TIME GRID (Row 3: 144-168, 24px boxes anchored to bottom) ===
+  // Sunrise/sunset arrow + time (42px wide) keep their 48px-cell offset, centered in wider cells
+  int time_width = bounds.size.w / GRID_TIME_COLUMNS;
+  int time_inset = (time_width - 48) / 2 + 6;
+  int sunrise_x = grid_column_x(GRID_TIME_COLUMNS - 2, GRID_TIME_COLUMNS, bounds.size.w) + time_inset;
+  int sunset_x = grid_column_x(GRID_TIME_COLUMNS - 1, GRID_TIME_COLUMNS, bounds.size.w) + time_inset;
+
+#if FEATURE_TIDE
   // Tide - Left column (0-48) - H/L + time, centered
   s_tide_layer = create_text_layer(
     GRect(0, 148, 48, 18),
@@ -1056,27 +2560,24 @@ static void main_window_load(Window *window) {
   layer_add_child(window_layer, text_layer_get_layer(s_tide_layer));
 
   // Load wave bitmap (hidden, kept for compatibility)
-  s_wave_bitmap = gbitmap_create_with_resource(
-    s_config.invert_colors ? RESOURCE_ID_WAVE_INVERTED : RESOURCE_ID_WAVE
-  );
+  s_wave_bitmap = gbitmap_create_with_resource(RESOURCE_ID_WAVE);
   s_wave_layer = bitmap_layer_create(GRect(6, 149, 10, 10));
   bitmap_layer_set_bitmap(s_wave_layer, s_wave_bitmap);
   bitmap_layer_set_compositing_mode(s_wave_layer, get_bitmap_compositing_mode());
   layer_add_child(window_layer, bitmap_layer_get_layer(s_wave_layer));
   layer_set_hidden(bitmap_layer_get_layer(s_wave_layer), true);
+#endif
 
   // Sunrise - Middle column (48-96) with arrow bitmap
   // Load arrow up bitmap
-  s_arrow_up_bitmap = gbitmap_create_with_resource(
-    s_config.invert_colors ? RESOURCE_ID_ARROW_UP_INVERTED : RESOURCE_ID_ARROW_UP
-  );
-  s_arrow_up_layer = bitmap_layer_create(GRect(54, 149, 10, 10));
+  s_arrow_up_bitmap = gbitmap_create_with_resource(RESOURCE_ID_ARROW_UP);
+  s_arrow_up_layer = bitmap_layer_create(GRect(sunrise_x, 149, 10, 10));
   bitmap_layer_set_bitmap(s_arrow_up_layer, s_arrow_up_bitmap);
   bitmap_layer_set_compositing_mode(s_arrow_up_layer, get_bitmap_compositing_mode());
   layer_add_child(window_layer, bitmap_layer_get_layer(s_arrow_up_layer));
 
   s_sunrise_layer = create_text_layer(
-    GRect(64, 148, 32, 18),
+    GRect(sunrise_x + 10, 148, 32, 18),
     GTextAlignmentLeft,
     fonts_get_system_font(FONT_KEY_GOTHIC_14)
   );
@@ -1084,31 +2585,32 @@ static void main_window_load(Window *window) {
 
   // Sunset - Right column (96-144) with arrow bitmap
   // Load arrow down bitmap
-  s_arrow_down_bitmap = gbitmap_create_with_resource(
-    s_config.invert_colors ? RESOURCE_ID_ARROW_DOWN_INVERTED : RESOURCE_ID_ARROW_DOWN
-  );
-  s_arrow_down_layer = bitmap_layer_create(GRect(102, 149, 10, 10));
+  s_arrow_down_bitmap = gbitmap_create_with_resource(RESOURCE_ID_ARROW_DOWN);
+  s_arrow_down_layer = bitmap_layer_create(GRect(sunset_x, 149, 10, 10));
   bitmap_layer_set_bitmap(s_arrow_down_layer, s_arrow_down_bitmap);
   bitmap_layer_set_compositing_mode(s_arrow_down_layer, get_bitmap_compositing_mode());
   layer_add_child(window_layer, bitmap_layer_get_layer(s_arrow_down_layer));
 
   s_sunset_layer = create_text_layer(
-    GRect(112, 148, 32, 18),
+    GRect(sunset_x + 10, 148, 32, 18),
     GTextAlignmentLeft,
     fonts_get_system_font(FONT_KEY_GOTHIC_14)
   );
   layer_add_child(window_layer, text_layer_get_layer(s_sunset_layer));
 
   // Initial display update (config and data already loaded in init())
-  update_time();
+  time_t now = time(NULL);
+  update_time(localtime(&now));
   update_weather_display();
-
-  // Request fresh weather data
-  request_weather_update();
 }
 
 // Window unload handler
 static void main_window_unload(Window *window) {
+  if (s_detail_timer) {
+    app_timer_cancel(s_detail_timer);
+  }
+  hide_detail_page(NULL);
+
   // Destroy divider layer
   layer_destroy(s_divider_layer);
 
@@ -1142,26 +2644,38 @@ static void main_window_unload(Window *window) {
   // Destroy arrow and wave bitmaps and layers
   gbitmap_destroy(s_arrow_up_bitmap);
   gbitmap_destroy(s_arrow_down_bitmap);
-  gbitmap_destroy(s_wave_bitmap);
   bitmap_layer_destroy(s_arrow_up_layer);
   bitmap_layer_destroy(s_arrow_down_layer);
+#if FEATURE_TIDE
+  gbitmap_destroy(s_wave_bitmap);
   bitmap_layer_destroy(s_wave_layer);
+#endif
 
   // Destroy text layers
   text_layer_destroy(s_time_layer);
   text_layer_destroy(s_date_layer);
-  text_layer_destroy(s_alert_layer);
   text_layer_destroy(s_location_layer);
-  text_layer_destroy(s_muni_layer);
   text_layer_destroy(s_temp_min_layer);
   text_layer_destroy(s_temp_current_layer);
   text_layer_destroy(s_temp_max_layer);
   text_layer_destroy(s_wind_layer);
   text_layer_destroy(s_uv_layer);
+  text_layer_destroy(s_precip_layer);
+#if FEATURE_ALERTS
+  text_layer_destroy(s_alert_layer);
+#endif
+#if FEATURE_MUNI
+  text_layer_destroy(s_muni_layer);
+#endif
+#if FEATURE_AQI
   text_layer_destroy(s_aqi_layer);
+#endif
+#if FEATURE_TIDE
   text_layer_destroy(s_tide_layer);
+#endif
+#if FEATURE_POLLEN
   text_layer_destroy(s_pollen_layer);
-  text_layer_destroy(s_precip_layer);
+#endif
   text_layer_destroy(s_sunrise_layer);
   text_layer_destroy(s_sunset_layer);
 }
@@ -1171,6 +2685,14 @@ static void init() {
   // Load persisted config and data BEFORE creating UI
   load_config();
   load_persisted_data();
+  log_event(EVENT_LAUNCH, 0);
+  validate_message_slots();
+  s_phone_connected = connection_service_peek_pebble_app_connection();
+  update_sun_times();
+  time_t now = time(NULL);
+  s_freshness_state = get_freshness_state(now);
+  update_power_profile(localtime(&now));
+  s_shown_nowcast = nowcast_display_state(now);  // Rain already due at launch doesn't vibrate
 
   // Create main window
   s_main_window = window_create();
@@ -1180,12 +2702,18 @@ static void init() {
   });
   window_stack_push(s_main_window, true);
 
+#if FEATURE_ALERTS
   // Clear any stale alerts on init
   s_weather_data.alert_active = false;
   s_weather_data.alert_text[0] = '\0';
+#endif
 
   // Register with TickTimerService
   tick_timer_service_subscribe(MINUTE_UNIT, tick_handler);
+  accel_tap_service_subscribe(accel_tap_handler);
+  connection_service_subscribe((ConnectionHandlers) {
+    .pebble_app_connection_handler = app_connection_handler
+  });
 
   // Register callbacks for AppMessage
   app_message_register_inbox_received(inbox_received_callback);
@@ -1193,14 +2721,27 @@ static void init() {
   app_message_register_outbox_failed(outbox_failed_callback);
   app_message_register_outbox_sent(outbox_sent_callback);
 
-  // Open AppMessage with large buffer
-  const int inbox_size = 512;
+  // Open AppMessage with the largest inbox the platform allows (capped to save
+  // heap); syncs that still don't fit arrive as chunked transfers
+  s_inbox_size = MIN(app_message_inbox_size_maximum(), INBOX_SIZE_LIMIT);
   const int outbox_size = 128;
-  app_message_open(inbox_size, outbox_size);
+  app_message_open(s_inbox_size, outbox_size);
+
+  // Request fresh data for every group (the outbox only works once opened)
+  if (s_phone_connected) {
+    request_weather_update(ALL_GROUPS);
+  }
+
+#ifdef FITZFACE_BENCHMARK
+  benchmark_tick_path();
+#endif
 }
 
 // Deinitialize app
 static void deinit() {
+  persist_write_data(PERSIST_KEY_EVENT_LOG, &s_event_log, sizeof(s_event_log));
+  accel_tap_service_unsubscribe();
+  connection_service_unsubscribe();
   window_destroy(s_main_window);
 }
 
@@ -1,3 +1,15 @@
+// Hour options for the quiet hours selects ("0" - "23")
+function hourOptions() {
+  var options = [];
+  for (var hour = 0; hour < 24; hour++) {
+    options.push({
+      "label": (hour % 12 || 12) + (hour < 12 ? " AM" : " PM"),
+      "value": String(hour)
+    });
+  }
+  return options;
+}
+
 module.exports = [
   {
     "type": "heading",
@@ -28,6 +40,18 @@ module.exports = [
           }
         ]
       },
+      {
+        "type": "select",
+        "messageKey": "CONFIG_WIND_UNIT",
+        "label": "Wind Speed Unit",
+        "defaultValue": "mph",
+        "options": [
+          { "label": "mph", "value": "mph" },
+          { "label": "km/h", "value": "kmh" },
+          { "label": "m/s", "value": "ms" },
+          { "label": "Knots", "value": "kn" }
+        ]
+      },
       {
         "type": "toggle",
         "messageKey": "INVERT",
@@ -49,10 +73,10 @@ module.exports = [
         "type": "input",
         "messageKey": "TIDE_STATION",
         "label": "NOAA Station ID",
-        "description": "Find your station at tidesandcurrents.noaa.gov<br><small>San Francisco: 9414290 | New York: 8518750 | Seattle: 9447130</small>",
-        "defaultValue": "9414290",
+        "description": "Leave empty to use the station nearest to you, or enter one from tidesandcurrents.noaa.gov<br><small>San Francisco: 9414290 | New York: 8518750 | Seattle: 9447130</small>",
+        "defaultValue": "",
         "attributes": {
-          "placeholder": "e.g., 9414290",
+          "placeholder": "Nearest station",
           "type": "text"
         }
       }
@@ -121,6 +145,28 @@ module.exports = [
             "value": "OB"
           }
         ]
+      },
+      {
+        "type": "input",
+        "messageKey": "MUNI_EXTRA_ROUTES",
+        "label": "Additional Routes",
+        "description": "Up to 2 more as stop/route/direction, comma separated<br><small>e.g. 15553/38/IB, 13565/N/OB - routes at the same stop share one request</small>",
+        "defaultValue": "",
+        "attributes": {
+          "placeholder": "e.g., 15553/38/IB",
+          "type": "text"
+        }
+      },
+      {
+        "type": "input",
+        "messageKey": "MUNI_SCHEDULE_URL",
+        "label": "Schedule Index URL",
+        "description": "Optional schedule built with tools/muni_schedule.py, shown (marked *) when real-time arrivals are unavailable",
+        "defaultValue": "",
+        "attributes": {
+          "placeholder": "https://...",
+          "type": "url"
+        }
       }
     ]
   },
@@ -152,6 +198,75 @@ module.exports = [
       }
     ]
   },
+  {
+    "type": "section",
+    "items": [
+      {
+        "type": "heading",
+        "defaultValue": "Saved Places",
+        "size": 3
+      },
+      {
+        "type": "input",
+        "messageKey": "SAVED_PLACES",
+        "label": "Places",
+        "description": "Up to 4 places as name@latitude,longitude separated by semicolons. Weather for each is cached so the watch switches instantly when you arrive.<br><small>e.g. Home@37.77,-122.42; Work@37.79,-122.40</small>",
+        "defaultValue": "",
+        "attributes": {
+          "placeholder": "Home@37.77,-122.42",
+          "type": "text"
+        }
+      }
+    ]
+  },
+  {
+    "type": "section",
+    "items": [
+      {
+        "type": "heading",
+        "defaultValue": "Quiet Hours",
+        "size": 3
+      },
+      {
+        "type": "select",
+        "messageKey": "QUIET_START",
+        "label": "Start",
+        "description": "During quiet hours the watch syncs at most hourly, skips MUNI and pollen, and doesn't vibrate. It also syncs less on low battery and pauses syncing while you sleep.",
+        "defaultValue": "-1",
+        "options": [{ "label": "Off", "value": "-1" }].concat(hourOptions())
+      },
+      {
+        "type": "select",
+        "messageKey": "QUIET_END",
+        "label": "End",
+        "defaultValue": "7",
+        "options": hourOptions()
+      }
+    ]
+  },
+  {
+    "type": "section",
+    "items": [
+      {
+        "type": "heading",
+        "defaultValue": "Diagnostics",
+        "size": 3
+      },
+      {
+        "type": "select",
+        "messageKey": "LOG_LEVEL",
+        "label": "Phone Log Level",
+        "description": "Info and Debug also print the watch's event log (recent syncs, requests, errors and power profile changes) to the phone log when saved.",
+        "defaultValue": "1",
+        "options": [
+          { "label": "Errors", "value": "0" },
+          { "label": "Warnings", "value": "1" },
+          { "label": "Info", "value": "2" },
+          { "label": "Debug", "value": "3" }
+        ]
+      }
+    ]
+  },
   {
     "type": "section",
     "items": [
@@ -4,11 +4,18 @@
 var Clay = require('pebble-clay');
 var clayConfig = require('./config');
 var clay = new Clay(clayConfig);
+var tides = require('./tides');
+var stations = require('./stations');
+var schedule = require('./schedule');
+var openMeteo = require('./openmeteo');
+var transfer = require('./transfer');
+var messageKeys = require('message_keys');
 
 // Configuration
 var CONFIG = {
-  TIDE_STATION: '9414290', // Default: San Francisco
+  TIDE_STATION: '',  // NOAA station ID ('' = nearest to the current location)
   TEMP_UNIT: 'F',
+  WIND_UNIT: 'mph',
   SHOW_AQI: true,
   SHOW_UV: true,
   SHOW_WIND: true,
@@ -20,13 +27,179 @@ var CONFIG = {
   MUNI_STOP_CODE: '',
   MUNI_ROUTE: '',
   MUNI_DIRECTION: 'IB',
+  MUNI_EXTRA_ROUTES: '',  // "stop/route/direction, ..." for additional routes
+  MUNI_SCHEDULE_URL: '',  // Schedule index from tools/muni_schedule.py ('' = real-time only)
   POLLEN_ENABLED: false,
-  POLLEN_API_KEY: ''
+  POLLEN_API_KEY: '',
+  SAVED_PLACES: '',  // "Name@lat,lon; ..." up to SAVED_PLACE_MAX places
+  QUIET_START: -1,   // Quiet hours start hour on the watch (-1 = off)
+  QUIET_END: 7,      // Quiet hours end hour (exclusive)
+  LOG_LEVEL: 1       // LOG.WARN
 };
 
+// Log levels - messages above CONFIG.LOG_LEVEL are dropped. Callers building
+// expensive strings (JSON, joins) check logEnabled() first.
+var LOG = { ERROR: 0, WARN: 1, INFO: 2, DEBUG: 3 };
+
+function logEnabled(level) {
+  return level <= CONFIG.LOG_LEVEL;
+}
+
+function log(level, message) {
+  if (level <= CONFIG.LOG_LEVEL) {
+    console.log(message);
+  }
+}
+
+// Watch event log (EventType in fitzface.c), requested when the log level is raised
+var EVENT_NAMES = [null, 'launch', 'request', 'sync', 'inbox dropped', 'outbox failed', 'power profile',
+                   'schema scan', 'connection', 'transfer'];
+var EVENT_LOG_ENTRY_SIZE = 7;
+
 // Cache for location
 var lastLocation = null;
 
+// Provider health tracking (circuit breaker per data provider)
+// After HEALTH_FAILURE_THRESHOLD consecutive failures a provider's circuit opens
+// and it is skipped until its backoff expires; the next sync then sends a single
+// half-open probe. Each failed probe doubles the backoff up to HEALTH_MAX_BACKOFF.
+var HEALTH_FAILURE_THRESHOLD = 2;
+var HEALTH_BASE_BACKOFF = 30 * 60 * 1000;     // 30 minutes
+var HEALTH_MAX_BACKOFF = 6 * 60 * 60 * 1000;  // 6 hours
+var HEALTH_PROBE_TIMEOUT = 60 * 1000;         // Allow a new probe if one never reported back
+var providerHealth = {};
+var providerDataTime = {};  // Unix time of the data last delivered per provider (fresh or cached)
+var CACHE_RADIUS = 10000;   // Meters: location-based cached data is only served this close to where it was fetched
+
+// MUNI table limits (must match MUNI_MAX_ROUTES/MUNI_MAX_ARRIVALS in fitzface.c)
+var MUNI_MAX_ROUTES = 3;
+var MUNI_MAX_ARRIVALS = 6;
+var MUNI_ROUTE_SCHEDULED = 0x80;  // Set on a route label's first byte when arrivals are scheduled
+
+// MUNI schedule fallback (schedule.js): scheduled arrivals from a cached GTFS
+// index replace real-time predictions that are unavailable or used up
+var MUNI_SCHEDULE_MAX_AGE = 7 * 24 * 60 * 60 * 1000;  // Re-download the index weekly
+var MUNI_SCHEDULE_HORIZON = 3 * 60 * 60;              // Seconds of scheduled arrivals sent
+
+// Detail page forecasts (must match PRECIP_HOURS/TIDE_TABLE_MAX in fitzface.c)
+var PRECIP_HOURS = 6;
+var TIDE_TABLE_MAX = 4;
+
+// 15-minute precipitation nowcast (must match NOWCAST_SLOTS in fitzface.c): the
+// next 3 hours, quantized to 2 bits per slot by precipitation per slot in mm
+var NOWCAST_SLOTS = 12;
+var NOWCAST_SLOT_SECONDS = 15 * 60;
+var NOWCAST_LEVELS = [0.1, 0.6, 1.9];  // Light, moderate (2.5 mm/h), heavy (7.6 mm/h)
+
+// Days in the DAILY_WEATHER/DAILY_POLLEN tables (must match FORECAST_DAYS in fitzface.c)
+var FORECAST_DAYS = 5;
+
+// Tide engine: harmonic constants are downloaded once per station and tides are
+// computed locally; NOAA's own predictions are only fetched to validate the model
+var TIDE_MODEL_MAX_AGE = 365 * 24 * 60 * 60 * 1000;      // Re-download constants yearly
+var TIDE_VALIDATION_INTERVAL = 7 * 24 * 60 * 60 * 1000;  // Check against NOAA weekly
+var TIDE_MAX_ERROR_MINUTES = 20;
+var TIDE_MAX_ERROR_HEIGHT = 0.5;  // Feet
+
+// Nearest tide station (stations.js): NOAA's station list is downloaded once into a
+// grid index; the station is re-picked only when the location enters another cell
+var TIDE_STATION_INDEX_MAX_AGE = 90 * 24 * 60 * 60 * 1000;
+var DEFAULT_TIDE_STATION = '9414290';  // San Francisco, until a location is known
+
+// Saved places: named coordinates whose weather is prefetched and cached so the
+// watch can switch to them instantly when the phone arrives
+var SAVED_PLACE_MAX = 4;
+var SAVED_PLACE_RADIUS = 1000;                       // Meters
+var SAVED_PLACE_PREFETCH_AGE = 3 * 60 * 60 * 1000;   // Refresh snapshots older than 3 hours
+var currentPlace = null;    // Name of the saved place the watch is showing (null = none)
+var locationWatchId = null;
+
+// Coordinates for the watch's sunrise/sunset calculator, resent only after moving
+var COORDINATE_RESEND_DISTANCE = 1000;  // Meters
+var sentCoordinates = null;  // Last coordinates the watch acknowledged (null = resend)
+
+// Features compiled into the watch build (WATCH_FEATURES bitmask, see wscript).
+// Fetches and message keys for missing features are skipped.
+var WATCH_FEATURE = { MUNI: 1, POLLEN: 2, TIDE: 4, AQI: 8, ALERTS: 16, INVERT: 32 };
+var watchFeatures = 0x3f;  // Assume everything until the watch reports
+
+function watchHas(feature) {
+  return (watchFeatures & WATCH_FEATURE[feature]) !== 0;
+}
+
+// Chunked transfers (transfer.js): messages larger than the watch's inbox
+// (INBOX_SIZE, reported with every request) are sent in chunks the watch
+// acknowledges one by one. A stalled transfer is kept so the watch can resume it
+// after a disconnect by sending its TRANSFER_ACK with the next request.
+var DEFAULT_INBOX_SIZE = 512;                // Smallest inbox a watch build opens
+var DEFAULT_TRANSFER_CAPACITY = 1024;        // Smallest reassembly buffer (TRANSFER_CAPACITY)
+var TRANSFER_REJECTED = 0xFF;                // TRANSFER_ACK of a transfer the watch refused
+var TRANSFER_ACK_TIMEOUT = 5000;
+var TRANSFER_MAX_RETRIES = 3;
+var TRANSFER_RESUME_AGE = 10 * 60 * 1000;    // Older transfers are replaced by a fresh sync
+var watchInboxSize = DEFAULT_INBOX_SIZE;
+var watchTransferCapacity = DEFAULT_TRANSFER_CAPACITY;
+var pendingTransfer = null;
+
+// Benchmark builds (FITZFACE_BENCHMARK=<url>, tools/benchmark/timeline.py) report a
+// local endpoint that stands in for every provider and scripts config changes.
+// Remembered for the launch sync; cleared by the first request from a normal build.
+var benchmarkEndpoint = localStorage.getItem('fitzface_benchmark_endpoint');
+
+// Provider URL, routed through the benchmark endpoint when one is set
+// ("https://host/path" -> "<endpoint>/host/path")
+function providerUrl(url) {
+  return benchmarkEndpoint ? benchmarkEndpoint + '/' + url.replace(/^https?:\/\//, '') : url;
+}
+
+// Power profile the watch reported with its last request (PowerProfile in fitzface.c).
+// Quiet and low-battery profiles skip MUNI and pollen; sleep also holds off the
+// phone's own background syncs and prefetches.
+var POWER_PROFILE = { NORMAL: 0, QUIET: 1, LOW_BATTERY: 2, SLEEP: 3 };
+var watchPowerProfile = POWER_PROFILE.NORMAL;
+
+function isReducedPowerProfile() {
+  return watchPowerProfile !== POWER_PROFILE.NORMAL;
+}
+
+// Data groups the watch can request in REFRESH_SOURCES (GROUP_BIT of DataGroup in fitzface.c)
+var SOURCE_BIT = { weather: 1, aqi: 2, tide: 4, muni: 8, pollen: 16, location: 32, daily: 64 };
+
+// Data groups this sync fetches: the groups the watch requested, or everything
+// the power profile allows for syncs started by the phone. Skipped groups keep
+// their previous values on the watch (no data keys, UPDATED_* = 0).
+function syncSources(requested) {
+  var sources = {};
+  for (var name in SOURCE_BIT) {
+    if (requested !== undefined) {
+      sources[name] = (requested & SOURCE_BIT[name]) !== 0;
+    } else {
+      sources[name] = !isReducedPowerProfile() || (name !== 'muni' && name !== 'pollen');
+    }
+  }
+  return sources;
+}
+
+// Restore what the watch last reported (features, inbox and transfer sizes, power profile)
+function loadWatchState() {
+  var stored = localStorage.getItem('fitzface_watch_features');
+  if (stored !== null) {
+    watchFeatures = parseInt(stored, 10);
+  }
+  stored = localStorage.getItem('fitzface_inbox_size');
+  if (stored !== null) {
+    watchInboxSize = parseInt(stored, 10);
+  }
+  stored = localStorage.getItem('fitzface_transfer_capacity');
+  if (stored !== null) {
+    watchTransferCapacity = parseInt(stored, 10);
+  }
+  stored = localStorage.getItem('fitzface_power_profile');
+  if (stored !== null) {
+    watchPowerProfile = parseInt(stored, 10);
+  }
+}
+
 // Load configuration from localStorage
 function loadConfig() {
   var stored = localStorage.getItem('fitzface_config');
@@ -34,12 +207,12 @@ function loadConfig() {
     try {
       var config = JSON.parse(stored);
       CONFIG = Object.assign(CONFIG, config);
-      console.log('Loaded config from storage:', JSON.stringify(CONFIG));
+      log(LOG.DEBUG, 'Loaded config from storage');  // Not the values: they include API keys
     } catch (e) {
-      console.log('Error loading config: ' + e);
+      log(LOG.WARN, 'Error loading config: ' + e);
     }
   } else {
-    console.log('No stored config, using defaults:', JSON.stringify(CONFIG));
+    log(LOG.DEBUG, 'No stored config, using defaults');
   }
 }
 
@@ -48,25 +221,177 @@ function saveConfig() {
   localStorage.setItem('fitzface_config', JSON.stringify(CONFIG));
 }
 
+// Drop weather caches stored in display units before canonical units
+function migrateCacheUnits() {
+  if (localStorage.getItem('fitzface_cache_units') === CACHE_UNITS) {
+    return;
+  }
+  localStorage.removeItem('fitzface_cache_weather');
+  localStorage.removeItem('fitzface_cache_daily');
+  var places = getSavedPlaces();
+  for (var i = 0; i < places.length; i++) {
+    localStorage.removeItem(placeSnapshotKey(places[i]));
+  }
+  localStorage.setItem('fitzface_cache_units', CACHE_UNITS);
+}
+
+// Load provider health state from localStorage
+function loadProviderHealth() {
+  var stored = localStorage.getItem('fitzface_provider_health');
+  if (stored) {
+    try {
+      providerHealth = JSON.parse(stored) || {};
+    } catch (e) {
+      log(LOG.WARN, 'Error loading provider health: ' + e);
+      providerHealth = {};
+    }
+  }
+}
+
+// Save provider health state to localStorage
+function saveProviderHealth() {
+  localStorage.setItem('fitzface_provider_health', JSON.stringify(providerHealth));
+}
+
+function getProviderHealth(name) {
+  if (!providerHealth[name]) {
+    providerHealth[name] = { failures: 0, openUntil: 0, probeAt: 0 };
+  }
+  return providerHealth[name];
+}
+
+// Check whether a provider may be called now (closed circuit or half-open probe)
+function providerAllowed(name) {
+  var health = getProviderHealth(name);
+  var now = Date.now();
+
+  if (health.failures < HEALTH_FAILURE_THRESHOLD) {
+    return true;  // Closed
+  }
+
+  if (now < health.openUntil) {
+    log(LOG.INFO, 'Provider ' + name + ' circuit open, retry in ' +
+                  Math.round((health.openUntil - now) / 60000) + ' min');
+    return false;
+  }
+
+  // Half-open: let exactly one probe through
+  if (health.probeAt && now - health.probeAt < HEALTH_PROBE_TIMEOUT) {
+    log(LOG.DEBUG, 'Provider ' + name + ' probe already in flight');
+    return false;
+  }
+  log(LOG.DEBUG, 'Provider ' + name + ' half-open, sending probe');
+  health.probeAt = now;
+  saveProviderHealth();
+  return true;
+}
+
+// Record a successful provider response and cache it as the last good value.
+// Location-based providers pass the location the data is for, so the cache is
+// only served near it (prefetches for other places aren't cached at all); tides
+// pass { station: id } so the cache is only served for that station.
+function providerSucceeded(name, data, location) {
+  var health = getProviderHealth(name);
+  if (health.failures >= HEALTH_FAILURE_THRESHOLD) {
+    log(LOG.INFO, 'Provider ' + name + ' recovered, closing circuit');
+  }
+  health.failures = 0;
+  health.openUntil = 0;
+  health.probeAt = 0;
+  saveProviderHealth();
+
+  var now = Math.floor(Date.now() / 1000);
+  providerDataTime[name] = now;
+  if (data !== null && data !== undefined && !(location && location.prefetch)) {
+    var entry = { time: now, data: data };
+    if (location && location.station !== undefined) {
+      entry.station = location.station;
+    } else if (location) {
+      entry.lat = location.lat;
+      entry.lon = location.lon;
+    }
+    localStorage.setItem('fitzface_cache_' + name, JSON.stringify(entry));
+  }
+}
+
+// Record a provider failure, open the circuit with exponential backoff once the
+// threshold is reached, and return the last good cached value (or null)
+function providerFailed(name, location) {
+  var health = getProviderHealth(name);
+  health.failures++;
+  health.probeAt = 0;
+
+  if (health.failures >= HEALTH_FAILURE_THRESHOLD) {
+    var backoff = HEALTH_BASE_BACKOFF * Math.pow(2, health.failures - HEALTH_FAILURE_THRESHOLD);
+    backoff = Math.min(backoff, HEALTH_MAX_BACKOFF);
+    health.openUntil = Date.now() + backoff;
+    log(LOG.INFO, 'Provider ' + name + ' failed ' + health.failures + 'x, circuit open for ' +
+                  Math.round(backoff / 60000) + ' min');
+  }
+  saveProviderHealth();
+
+  return cachedProviderData(name, location);
+}
+
+// Whether a cache entry is for the given location (within CACHE_RADIUS) or station
+function cacheEntryMatches(entry, location) {
+  if (location.station !== undefined) {
+    return entry.station === location.station;
+  }
+  return entry.lat !== undefined &&
+         distanceMeters(location, { lat: entry.lat, lon: entry.lon }) <= CACHE_RADIUS;
+}
+
+// Return the last good value for a provider, logging its age. With a location or
+// station, data cached for another one (or before entries recorded which) is not served.
+function cachedProviderData(name, location) {
+  var stored = localStorage.getItem('fitzface_cache_' + name);
+  if (!stored) {
+    return null;
+  }
+  try {
+    var entry = JSON.parse(stored);
+    if (location && !cacheEntryMatches(entry, location)) {
+      log(LOG.DEBUG, 'Cached ' + name + ' data is for another location');
+      return null;
+    }
+    var age = Math.floor(Date.now() / 1000) - entry.time;
+    log(LOG.DEBUG, 'Serving cached ' + name + ' data (' + Math.round(age / 60) + ' min old)');
+    providerDataTime[name] = entry.time;
+    return entry.data;
+  } catch (e) {
+    log(LOG.WARN, 'Error reading cached ' + name + ' data: ' + e);
+    return null;
+  }
+}
+
+// Provider name for a location-based fetch. Saved-place prefetches keep their own
+// circuit breaker and data time, so they never mark the wearer's data fresh or
+// stale and their failures don't open the wearer's circuit.
+function locationProvider(name, location) {
+  return location.prefetch ? 'prefetch_' + name : name;
+}
+
 // Get location using Geolocation API
 function getLocation(callback) {
-  console.log('Requesting location...');
+  log(LOG.DEBUG, 'Requesting location...');
 
   navigator.geolocation.getCurrentPosition(
     function(pos) {
       var location = {
         lat: pos.coords.latitude,
-        lon: pos.coords.longitude
+        lon: pos.coords.longitude,
+        time: Math.floor(Date.now() / 1000)  // When this fix was taken
       };
-      console.log('Location acquired: ' + location.lat + ', ' + location.lon);
+      log(LOG.DEBUG, 'Location acquired: ' + location.lat + ', ' + location.lon);
       lastLocation = location;
       callback(location);
     },
     function(err) {
-      console.log('Location error: ' + err.message);
+      log(LOG.WARN, 'Location error: ' + err.message);
       // Use cached location if available
       if (lastLocation) {
-        console.log('Using cached location');
+        log(LOG.DEBUG, 'Using cached location');
         callback(lastLocation);
       } else {
         callback(null);
@@ -79,118 +404,498 @@ function getLocation(callback) {
   );
 }
 
+// Open-Meteo variables per response section. FlatBuffers responses list the
+// variables in request order, so the query is always built from these lists.
+var WEATHER_VARIABLES = {
+  current: ['temperature_2m', 'wind_speed_10m', 'weather_code', 'uv_index'],
+  hourly: ['precipitation_probability', 'precipitation', 'wind_gusts_10m', 'weather_code', 'temperature_2m', 'uv_index'],
+  minutely_15: ['precipitation']
+};
+var DAILY_VARIABLES = {
+  daily: ['weather_code', 'temperature_2m_max', 'temperature_2m_min', 'precipitation_probability_max', 'uv_index_max']
+};
+var AQI_VARIABLES = {
+  current: ['us_aqi']
+};
+
+// Weather goes to the watch in canonical units (tenths of a degree Celsius, tenths
+// of a m/s) and the watch converts for display, so unit changes need no refetch
+// and cached responses stay valid. Wind units in CONFIG_WIND_UNIT order (WindUnit
+// in fitzface.c), with the speed per m/s for alert text.
+var WIND_UNITS = {
+  mph: { index: 0, perMs: 2.23694, label: 'mph' },
+  kmh: { index: 1, perMs: 3.6, label: 'km/h' },
+  ms: { index: 2, perMs: 1, label: 'm/s' },
+  kn: { index: 3, perMs: 1.94384, label: 'kn' }
+};
+var WIND_ALERT_GUST = 8.9;  // m/s (20 mph)
+
+// Cache format: bumped when cached provider data changes meaning
+var CACHE_UNITS = 'metric';
+
+// Request Open-Meteo responses as FlatBuffers (smaller, no JSON.parse of the
+// hourly arrays) until the runtime or a response can't be decoded, then JSON
+var openMeteoBinary = true;
+
+// GET an Open-Meteo URL and decode the requested variables. callback(err, response)
+// gets the JSON-shaped response whichever format was used.
+function requestOpenMeteo(url, variables, timeout, callback) {
+  var binary = openMeteoBinary;
+  var xhr = new XMLHttpRequest();
+  xhr.open('GET', providerUrl(binary ? url + '&format=flatbuffers' : url), true);
+  xhr.timeout = timeout;
+  if (binary) {
+    xhr.responseType = 'arraybuffer';
+  }
+
+  xhr.onload = function() {
+    if (xhr.readyState === 4) {
+      if (xhr.status !== 200) {
+        callback(new Error('Request failed: ' + xhr.status));
+        return;
+      }
+
+      var response;
+      try {
+        response = binary ? openMeteo.decode(xhr.response, variables) : JSON.parse(xhr.responseText);
+      } catch (e) {
+        if (binary) {
+          log(LOG.INFO, 'Open-Meteo FlatBuffers not usable (' + e.message + '), switching to JSON');
+          openMeteoBinary = false;
+          requestOpenMeteo(url, variables, timeout, callback);
+        } else {
+          callback(e);
+        }
+        return;
+      }
+      callback(null, response);
+    }
+  };
+
+  xhr.onerror = function() {
+    callback(new Error('Network error'));
+  };
+
+  xhr.ontimeout = function() {
+    callback(new Error('Timeout'));
+  };
+
+  xhr.send();
+}
+
 // Fetch weather data from Open-Meteo
 function fetchWeather(location, callback) {
-  var tempUnit = CONFIG.TEMP_UNIT === 'C' ? 'celsius' : 'fahrenheit';
-  console.log('Fetching weather with temperature unit:', tempUnit, '(CONFIG.TEMP_UNIT=' + CONFIG.TEMP_UNIT + ')');
+  var url = 'https://api.open-meteo.com/v1/forecast?' +
+    'latitude=' + location.lat +
+    '&longitude=' + location.lon +
+    openMeteo.query(WEATHER_VARIABLES) +
+    '&wind_speed_unit=ms' +
+    '&timezone=auto' +
+    '&forecast_hours=24' +
+    '&forecast_minutely_15=' + NOWCAST_SLOTS;
+  var provider = locationProvider('weather', location);
+
+  if (!providerAllowed(provider)) {
+    var cached = cachedProviderData(provider, location);
+    callback(cached ? null : new Error('Circuit open'), cached);
+    return;
+  }
+
+  log(LOG.DEBUG, 'Fetching weather from Open-Meteo...');
+
+  requestOpenMeteo(url, WEATHER_VARIABLES, 15000, function(err, response) {
+    if (err) {
+      // Fall back to the last good response when the request fails
+      log(LOG.WARN, 'Weather request failed: ' + err.message);
+      var cached = providerFailed(provider, location);
+      callback(cached ? null : err, cached);
+      return;
+    }
+    log(LOG.DEBUG, 'Weather data received');
+    providerSucceeded(provider, response, location);
+    callback(null, response);
+  });
+}
 
+// Fetch the multi-day forecast from Open-Meteo. The watch keeps FORECAST_DAYS
+// days and shifts them itself at midnight, so this runs about once a day.
+function fetchDailyForecast(location, callback) {
   var url = 'https://api.open-meteo.com/v1/forecast?' +
     'latitude=' + location.lat +
     '&longitude=' + location.lon +
-    '&current=temperature_2m,wind_speed_10m,weather_code,uv_index' +
-    '&hourly=precipitation_probability,precipitation,wind_gusts_10m,weather_code,temperature_2m,uv_index' +
-    '&daily=temperature_2m_max,temperature_2m_min,sunrise,sunset,wind_speed_10m_max,weather_code,precipitation_probability_max,wind_gusts_10m_max' +
-    '&temperature_unit=' + tempUnit +
-    '&wind_speed_unit=mph' +
-    '&precipitation_unit=inch' +
+    openMeteo.query(DAILY_VARIABLES) +
     '&timezone=auto' +
-    '&forecast_days=2' +
-    '&forecast_hours=24';
+    '&forecast_days=' + FORECAST_DAYS;
+  var provider = locationProvider('daily', location);
+
+  if (!providerAllowed(provider)) {
+    var cached = cachedProviderData(provider, location);
+    callback(cached ? null : new Error('Circuit open'), cached);
+    return;
+  }
+
+  log(LOG.DEBUG, 'Fetching daily forecast from Open-Meteo...');
 
-  console.log('Fetching weather from Open-Meteo...');
+  requestOpenMeteo(url, DAILY_VARIABLES, 15000, function(err, response) {
+    if (!err && (!response.daily || !response.daily.time || response.daily.time.length === 0)) {
+      err = new Error('No daily data');
+    }
+    if (err) {
+      // Fall back to the last good response when the request fails
+      log(LOG.WARN, 'Daily forecast request failed: ' + err.message);
+      var cached = providerFailed(provider, location);
+      callback(cached ? null : err, cached);
+      return;
+    }
+    log(LOG.DEBUG, 'Daily forecast received: ' + response.daily.time.length + ' days');
+    providerSucceeded(provider, response.daily, location);
+    callback(null, response.daily);
+  });
+}
+
+// Fetch AQI data from Open-Meteo Air Quality API
+function fetchAQI(location, callback) {
+  if (!watchHas('AQI')) {
+    callback(null, null);
+    return;
+  }
+  if (!CONFIG.SHOW_AQI) {
+    callback(null, { aqi: 0 });
+    return;
+  }
+
+  var url = 'https://air-quality-api.open-meteo.com/v1/air-quality?' +
+    'latitude=' + location.lat +
+    '&longitude=' + location.lon +
+    openMeteo.query(AQI_VARIABLES) +
+    '&timezone=auto';
+  var provider = locationProvider('aqi', location);
+
+  if (!providerAllowed(provider)) {
+    callback(null, cachedProviderData(provider, location) || { aqi: 0 });
+    return;
+  }
 
+  log(LOG.DEBUG, 'Fetching AQI data...');
+
+  requestOpenMeteo(url, AQI_VARIABLES, 15000, function(err, response) {
+    if (!err && !response.current) {
+      err = new Error('No current data');
+    }
+    if (err) {
+      log(LOG.WARN, 'AQI request failed: ' + err.message);
+      callback(null, providerFailed(provider, location) || { aqi: 0 });
+      return;
+    }
+    log(LOG.DEBUG, 'AQI data received: ' + response.current.us_aqi);
+    var aqiData = { aqi: Math.round(response.current.us_aqi || 0) };
+    providerSucceeded(provider, aqiData, location);
+    callback(null, aqiData);
+  });
+}
+
+// Fetch next tide, computed locally from the station's harmonic model when
+// available and falling back to NOAA's predictions otherwise
+function fetchTides(location, callback) {
+  if (!watchHas('TIDE') || !CONFIG.SHOW_TIDE) {
+    callback(null, null);
+    return;
+  }
+
+  resolveTideStation(location, function(station) {
+    fetchStationTides(station, callback);
+  });
+}
+
+function fetchStationTides(station, callback) {
+  var model = loadTideModel(station);
+  var age = model ? Date.now() - model.fetched : 0;
+
+  // A model that failed validation is retried (re-downloaded) after a week
+  var usable = model && age < TIDE_MODEL_MAX_AGE &&
+               !(model.valid === false && Date.now() - model.validated < TIDE_VALIDATION_INTERVAL);
+  var expired = !model || age >= TIDE_MODEL_MAX_AGE ||
+                (model.valid === false && Date.now() - model.validated >= TIDE_VALIDATION_INTERVAL);
+
+  if (usable) {
+    callback(null, selectUpcomingTides(predictTidesLocally(model)));
+    if (!model.validated || Date.now() - model.validated >= TIDE_VALIDATION_INTERVAL) {
+      validateTideModel(model);
+    }
+    return;
+  }
+
+  if (!expired) {
+    // Model known to be inaccurate - use NOAA until it is re-downloaded
+    fetchNOAAPredictions(station, function(predictions) {
+      callback(null, selectUpcomingTides(predictions));
+    });
+    return;
+  }
+
+  downloadTideModel(station, function(newModel) {
+    if (newModel) {
+      callback(null, selectUpcomingTides(predictTidesLocally(newModel)));
+      validateTideModel(newModel);
+    } else {
+      fetchNOAAPredictions(station, function(predictions) {
+        callback(null, selectUpcomingTides(predictions));
+      });
+    }
+  });
+}
+
+// Station for tides: the configured one, or the nearest to the location from the
+// cached station index. The pick is kept until the location changes cell.
+function resolveTideStation(location, callback) {
+  if (CONFIG.TIDE_STATION) {
+    callback(CONFIG.TIDE_STATION);
+    return;
+  }
+
+  var pick = loadJSON('fitzface_tide_station_pick');
+  location = location || lastLocation;
+  if (!location) {
+    callback(pick ? pick.station : DEFAULT_TIDE_STATION);
+    return;
+  }
+
+  var index = loadJSON('fitzface_tide_station_index');
+  var indexUsable = index && index.cells && Date.now() - index.fetched < TIDE_STATION_INDEX_MAX_AGE;
+  if (pick && indexUsable && pick.cell === stations.cellOf(index, location.lat, location.lon)) {
+    callback(pick.station);
+    return;
+  }
+
+  function pickFrom(stationIndex) {
+    if (!stationIndex) {
+      callback(pick ? pick.station : DEFAULT_TIDE_STATION);
+      return;
+    }
+    var nearest = stations.nearest(stationIndex, location.lat, location.lon);
+    if (!nearest) {
+      log(LOG.INFO, 'No tide station near the current location');
+      callback(pick ? pick.station : DEFAULT_TIDE_STATION);
+      return;
+    }
+    if (!pick || pick.station !== nearest.id) {
+      log(LOG.INFO, 'Nearest tide station: ' + nearest.id + ' (' + Math.round(nearest.km) + ' km)');
+    }
+    localStorage.setItem('fitzface_tide_station_pick', JSON.stringify({
+      cell: stations.cellOf(stationIndex, location.lat, location.lon),
+      station: nearest.id
+    }));
+    callback(nearest.id);
+  }
+
+  if (indexUsable) {
+    pickFrom(index);
+  } else {
+    downloadTideStationIndex(function(newIndex) {
+      pickFrom(newIndex || (index && index.cells ? index : null));  // An expired index beats none
+    });
+  }
+}
+
+function loadJSON(key) {
+  var stored = localStorage.getItem(key);
+  if (!stored) {
+    return null;
+  }
+  try {
+    return JSON.parse(stored);
+  } catch (e) {
+    log(LOG.WARN, 'Error reading ' + key + ': ' + e);
+    return null;
+  }
+}
+
+// Download NOAA's harmonic station list and cache it as a grid index
+function downloadTideStationIndex(callback) {
+  if (!providerAllowed('tide_stations')) {
+    callback(null);
+    return;
+  }
+
+  log(LOG.DEBUG, 'Downloading NOAA tide station list...');
   var xhr = new XMLHttpRequest();
-  xhr.open('GET', url, true);
-  xhr.timeout = 15000;
+  xhr.open('GET', providerUrl('https://api.tidesandcurrents.noaa.gov/mdapi/prod/webapi/stations.json?type=harcon'),
+           true);
+  xhr.timeout = 30000;
 
   xhr.onload = function() {
     if (xhr.readyState === 4) {
       if (xhr.status === 200) {
         try {
-          var response = JSON.parse(xhr.responseText);
-          console.log('Weather data received');
-          callback(null, response);
+          var index = stations.buildIndex(JSON.parse(xhr.responseText));
+          index.fetched = Date.now();
+          localStorage.setItem('fitzface_tide_station_index', JSON.stringify(index));
+          providerSucceeded('tide_stations', null);
+          log(LOG.INFO, 'Tide station index cached: ' + index.count + ' stations');
+          callback(index);
         } catch (e) {
-          console.log('Error parsing weather response: ' + e);
-          callback(e, null);
+          log(LOG.WARN, 'Error building tide station index: ' + e);
+          providerFailed('tide_stations');
+          callback(null);
         }
       } else {
-        console.log('Weather request failed: ' + xhr.status);
-        callback(new Error('Request failed: ' + xhr.status), null);
+        log(LOG.WARN, 'Tide station list request failed: ' + xhr.status);
+        providerFailed('tide_stations');
+        callback(null);
       }
     }
   };
 
   xhr.onerror = function() {
-    console.log('Weather request error');
-    callback(new Error('Network error'), null);
+    log(LOG.WARN, 'Tide station list request error');
+    providerFailed('tide_stations');
+    callback(null);
   };
 
   xhr.ontimeout = function() {
-    console.log('Weather request timeout');
-    callback(new Error('Timeout'), null);
+    log(LOG.WARN, 'Tide station list request timeout');
+    providerFailed('tide_stations');
+    callback(null);
   };
 
   xhr.send();
 }
 
-// Fetch AQI data from Open-Meteo Air Quality API
-function fetchAQI(location, callback) {
-  if (!CONFIG.SHOW_AQI) {
-    callback(null, { aqi: 0 });
+// Compute the next 48 hours of high/low tides in NOAA's prediction format
+function predictTidesLocally(model) {
+  var extremes = tides.predictExtremes(model, Date.now() - 60 * 60 * 1000, 48);
+  providerDataTime.tide = Math.floor(Date.now() / 1000);
+  log(LOG.DEBUG, 'Computed ' + extremes.length + ' tides locally for station ' + model.station);
+
+  return extremes.map(function(e) {
+    return { t: formatNOAATime(new Date(e.time * 1000)), v: e.height.toFixed(3), type: e.type };
+  });
+}
+
+function loadTideModel(station) {
+  var stored = localStorage.getItem('fitzface_tide_model_' + station);
+  if (!stored) {
+    return null;
+  }
+  try {
+    return JSON.parse(stored);
+  } catch (e) {
+    log(LOG.WARN, 'Error loading tide model: ' + e);
+    return null;
+  }
+}
+
+function saveTideModel(model) {
+  localStorage.setItem('fitzface_tide_model_' + model.station, JSON.stringify(model));
+}
+
+// Download a station's harmonic constituents and datums and cache the model
+function downloadTideModel(station, callback) {
+  if (!providerAllowed('tide_harcon')) {
+    callback(null);
     return;
   }
 
-  var url = 'https://air-quality-api.open-meteo.com/v1/air-quality?' +
-    'latitude=' + location.lat +
-    '&longitude=' + location.lon +
-    '&current=us_aqi' +
-    '&timezone=auto';
+  log(LOG.DEBUG, 'Downloading tide harmonic constants for station ' + station + '...');
 
-  console.log('Fetching AQI data...');
+  fetchNOAAMetadata(station, 'harcon', function(harcon) {
+    if (!harcon) {
+      callback(null);
+      return;
+    }
+    fetchNOAAMetadata(station, 'datums', function(datums) {
+      if (!datums) {
+        callback(null);
+        return;
+      }
+      try {
+        var model = tides.buildModel(station, harcon, datums);
+        model.fetched = Date.now();
+        model.validated = 0;
+        saveTideModel(model);
+        providerSucceeded('tide_harcon', null);
+        log(LOG.INFO, 'Tide model cached: ' + model.constituents.length + ' constituents');
+        callback(model);
+      } catch (e) {
+        log(LOG.WARN, 'Error building tide model: ' + e);
+        providerFailed('tide_harcon');
+        callback(null);
+      }
+    });
+  });
+}
+
+// Fetch a station metadata resource (harcon or datums) from NOAA
+function fetchNOAAMetadata(station, resource, callback) {
+  var url = 'https://api.tidesandcurrents.noaa.gov/mdapi/prod/webapi/stations/' +
+    encodeURIComponent(station) + '/' + resource + '.json?units=english';
 
   var xhr = new XMLHttpRequest();
-  xhr.open('GET', url, true);
+  xhr.open('GET', providerUrl(url), true);
   xhr.timeout = 15000;
 
   xhr.onload = function() {
     if (xhr.readyState === 4) {
       if (xhr.status === 200) {
         try {
-          var response = JSON.parse(xhr.responseText);
-          console.log('AQI data received: ' + response.current.us_aqi);
-          callback(null, { aqi: Math.round(response.current.us_aqi || 0) });
+          callback(JSON.parse(xhr.responseText));
         } catch (e) {
-          console.log('Error parsing AQI response: ' + e);
-          callback(null, { aqi: 0 });
+          log(LOG.WARN, 'Error parsing tide ' + resource + ' response: ' + e);
+          providerFailed('tide_harcon');
+          callback(null);
         }
       } else {
-        console.log('AQI request failed: ' + xhr.status);
-        callback(null, { aqi: 0 });
+        log(LOG.WARN, 'Tide ' + resource + ' request failed: ' + xhr.status);
+        providerFailed('tide_harcon');
+        callback(null);
       }
     }
   };
 
   xhr.onerror = function() {
-    console.log('AQI request error');
-    callback(null, { aqi: 0 });
+    log(LOG.WARN, 'Tide ' + resource + ' request error');
+    providerFailed('tide_harcon');
+    callback(null);
   };
 
   xhr.ontimeout = function() {
-    console.log('AQI request timeout');
-    callback(null, { aqi: 0 });
+    log(LOG.WARN, 'Tide ' + resource + ' request timeout');
+    providerFailed('tide_harcon');
+    callback(null);
   };
 
   xhr.send();
 }
 
-// Fetch tide data from NOAA
-function fetchTides(callback) {
-  if (!CONFIG.SHOW_TIDE || !CONFIG.TIDE_STATION) {
-    callback(null, null);
-    return;
-  }
+// Compare the local model against NOAA's published hilo predictions and
+// record whether it can be trusted. Only a fresh response for the model's own
+// station counts; without one the verdict and timestamp stay as they are.
+function validateTideModel(model) {
+  fetchNOAAPredictions(model.station, function(predictions) {
+    if (!predictions) {
+      return;
+    }
 
+    var extremes = tides.predictExtremes(model, Date.now() - 60 * 60 * 1000, 48);
+    var result = tides.compareWithNOAA(extremes, predictions, parseTideTime);
+    model.validated = Date.now();
+    if (result.matched < 2) {
+      // Keep the current verdict and try again next interval
+      log(LOG.WARN, 'Tide validation inconclusive (' + result.matched + ' matches)');
+      saveTideModel(model);
+      return;
+    }
+
+    model.valid = result.minutes <= TIDE_MAX_ERROR_MINUTES && result.height <= TIDE_MAX_ERROR_HEIGHT;
+    saveTideModel(model);
+    log(LOG.INFO, 'Tide model ' + (model.valid ? 'validated' : 'rejected') + ': max error ' +
+                  Math.round(result.minutes) + ' min, ' + result.height.toFixed(2) + ' ft');
+  }, true);
+}
+
+// Fetch 48 hours of hilo predictions from NOAA (used for validation and as fallback).
+// Unless fresh is set, a failed or skipped request answers with the station's cache.
+function fetchNOAAPredictions(station, callback, fresh) {
   var now = new Date();
   var tomorrow = new Date(now.getTime() + 48 * 60 * 60 * 1000);
 
@@ -203,16 +908,27 @@ function fetchTides(callback) {
     '&begin_date=' + beginDate +
     '&end_date=' + endDate +
     '&datum=MLLW' +
-    '&station=' + CONFIG.TIDE_STATION +
+    '&station=' + encodeURIComponent(station) +
     '&time_zone=lst_ldt' +
     '&units=english' +
     '&interval=hilo' +
     '&format=json';
 
-  console.log('Fetching tide data from NOAA...');
+  var scope = { station: station };  // The cache only answers for this station
+  function failed() {
+    var cached = providerFailed('tide', scope);
+    callback(fresh ? null : cached);
+  }
+
+  if (!providerAllowed('tide')) {
+    callback(fresh ? null : cachedProviderData('tide', scope));
+    return;
+  }
+
+  log(LOG.DEBUG, 'Fetching tide data from NOAA...');
 
   var xhr = new XMLHttpRequest();
-  xhr.open('GET', url, true);
+  xhr.open('GET', providerUrl(url), true);
   xhr.timeout = 15000;
 
   xhr.onload = function() {
@@ -221,53 +937,57 @@ function fetchTides(callback) {
         try {
           var response = JSON.parse(xhr.responseText);
           if (response.predictions && response.predictions.length > 0) {
-            // Find next tide (first prediction after now)
-            var now = new Date();
-            var nextTide = null;
-
-            for (var i = 0; i < response.predictions.length; i++) {
-              var tideTime = new Date(response.predictions[i].t);
-              if (tideTime > now) {
-                nextTide = response.predictions[i];
-                break;
-              }
-            }
-
-            if (nextTide) {
-              console.log('Next tide: ' + nextTide.type + ' at ' + nextTide.t);
-              callback(null, nextTide);
-            } else {
-              console.log('No future tide predictions available');
-              callback(null, null);
-            }
+            // Cache the full 48-hour schedule so a cached copy stays useful
+            providerSucceeded('tide', response.predictions, scope);
+            callback(response.predictions);
           } else {
-            console.log('No tide predictions available');
-            callback(null, null);
+            log(LOG.DEBUG, 'No tide predictions available');
+            providerSucceeded('tide', null, scope);
+            callback(null);
           }
         } catch (e) {
-          console.log('Error parsing tide response: ' + e);
-          callback(null, null);
+          log(LOG.WARN, 'Error parsing tide response: ' + e);
+          failed();
         }
       } else {
-        console.log('Tide request failed: ' + xhr.status);
-        callback(null, null);
+        log(LOG.WARN, 'Tide request failed: ' + xhr.status);
+        failed();
       }
     }
   };
 
   xhr.onerror = function() {
-    console.log('Tide request error');
-    callback(null, null);
+    log(LOG.WARN, 'Tide request error');
+    failed();
   };
 
   xhr.ontimeout = function() {
-    console.log('Tide request timeout');
-    callback(null, null);
+    log(LOG.WARN, 'Tide request timeout');
+    failed();
   };
 
   xhr.send();
 }
 
+// Find the next TIDE_TABLE_MAX tides (predictions after now, null if none)
+function selectUpcomingTides(predictions) {
+  if (!predictions) {
+    return null;
+  }
+
+  var now = new Date();
+  var upcoming = predictions.filter(function(prediction) {
+    return new Date(prediction.t) > now;
+  }).slice(0, TIDE_TABLE_MAX);
+
+  if (upcoming.length === 0) {
+    log(LOG.DEBUG, 'No future tide predictions available');
+    return null;
+  }
+  log(LOG.DEBUG, 'Next tide: ' + upcoming[0].type + ' at ' + upcoming[0].t);
+  return upcoming;
+}
+
 // Format date for NOAA API (YYYYMMDD)
 function formatNOAADate(date) {
   var year = date.getFullYear();
@@ -276,6 +996,13 @@ function formatNOAADate(date) {
   return year + month + day;
 }
 
+// Format date like NOAA's local prediction times ("YYYY-MM-DD HH:MM")
+function formatNOAATime(date) {
+  return date.getFullYear() + '-' + ('0' + (date.getMonth() + 1)).slice(-2) + '-' +
+    ('0' + date.getDate()).slice(-2) + ' ' + ('0' + date.getHours()).slice(-2) + ':' +
+    ('0' + date.getMinutes()).slice(-2);
+}
+
 // Parse NOAA tide time to Unix timestamp
 function parseTideTime(timeStr) {
   // Format: "YYYY-MM-DD HH:MM"
@@ -283,25 +1010,33 @@ function parseTideTime(timeStr) {
   return Math.floor(date.getTime() / 1000);
 }
 
-// Parse Open-Meteo ISO timestamp to Unix timestamp
-function parseISOTime(isoStr) {
-  var date = new Date(isoStr);
-  return Math.floor(date.getTime() / 1000);
-}
-
 // Reverse geocode to get location name
 function getLocationName(location, callback) {
+  // Saved places are already named - no lookup needed
+  var place = findSavedPlace(location);
+  if (place) {
+    providerDataTime.geocode = Math.floor(Date.now() / 1000);
+    callback(place.name);
+    return;
+  }
+
   // Use Nominatim reverse geocoding API
   var url = 'https://nominatim.openstreetmap.org/reverse?' +
     'lat=' + location.lat +
     '&lon=' + location.lon +
     '&format=json' +
     '&zoom=10';  // City level
+  var fallbackName = location.lat.toFixed(1) + '°, ' + location.lon.toFixed(1) + '°';
+
+  if (!providerAllowed('geocode')) {
+    callback(cachedProviderData('geocode', location) || fallbackName);
+    return;
+  }
 
-  console.log('Fetching city name from Nominatim...');
+  log(LOG.DEBUG, 'Fetching city name from Nominatim...');
 
   var xhr = new XMLHttpRequest();
-  xhr.open('GET', url, true);
+  xhr.open('GET', providerUrl(url), true);
   xhr.timeout = 10000;
   xhr.setRequestHeader('User-Agent', 'FitzFace Pebble Watchface');
 
@@ -316,50 +1051,239 @@ function getLocationName(location, callback) {
                      response.address.village ||
                      response.address.county ||
                      'Unknown';
-          console.log('City name: ' + city);
+          log(LOG.DEBUG, 'City name: ' + city);
+          providerSucceeded('geocode', city, location);
           callback(city);
         } catch (e) {
-          console.log('Error parsing geocoding response: ' + e);
-          callback(location.lat.toFixed(1) + '°, ' + location.lon.toFixed(1) + '°');
+          log(LOG.WARN, 'Error parsing geocoding response: ' + e);
+          callback(providerFailed('geocode', location) || fallbackName);
         }
       } else {
-        console.log('Geocoding request failed: ' + xhr.status);
-        callback(location.lat.toFixed(1) + '°, ' + location.lon.toFixed(1) + '°');
+        log(LOG.WARN, 'Geocoding request failed: ' + xhr.status);
+        callback(providerFailed('geocode', location) || fallbackName);
       }
     }
   };
 
   xhr.onerror = function() {
-    console.log('Geocoding request error');
-    callback(location.lat.toFixed(1) + '°, ' + location.lon.toFixed(1) + '°');
+    log(LOG.WARN, 'Geocoding request error');
+    callback(providerFailed('geocode', location) || fallbackName);
   };
 
   xhr.ontimeout = function() {
-    console.log('Geocoding request timeout');
-    callback(location.lat.toFixed(1) + '°, ' + location.lon.toFixed(1) + '°');
+    log(LOG.WARN, 'Geocoding request timeout');
+    callback(providerFailed('geocode', location) || fallbackName);
   };
 
   xhr.send();
 }
 
+// Parse configured MUNI route/stop pairs (primary route plus extras)
+// Extras use the format "stop/route/direction", comma separated, e.g. "15553/38/IB, 13565/N/OB"
+function getMuniRoutes() {
+  var routes = [];
+
+  if (CONFIG.MUNI_STOP_CODE && CONFIG.MUNI_ROUTE) {
+    routes.push({
+      stop: CONFIG.MUNI_STOP_CODE,
+      route: CONFIG.MUNI_ROUTE.toUpperCase(),
+      direction: CONFIG.MUNI_DIRECTION || 'IB'
+    });
+  }
+
+  var extras = (CONFIG.MUNI_EXTRA_ROUTES || '').split(',');
+  for (var i = 0; i < extras.length; i++) {
+    var parts = extras[i].trim().split('/');
+    if (parts.length < 2 || !parts[0].trim() || !parts[1].trim()) {
+      continue;
+    }
+    routes.push({
+      stop: parts[0].trim(),
+      route: parts[1].trim().toUpperCase(),
+      direction: (parts[2] || CONFIG.MUNI_DIRECTION || 'IB').trim().toUpperCase()
+    });
+  }
+
+  return routes.slice(0, MUNI_MAX_ROUTES);
+}
+
 // Fetch MUNI bus predictions from 511.org API
+// Makes one StopMonitoring request per distinct stop and returns a table of
+// [{ route, timestamps, scheduled }] in configured order (null if nothing is
+// configured). Routes without upcoming real-time arrivals fall back to the
+// schedule index; without an API key only the schedule is used.
 function fetchMuniBusPredictions(callback) {
-  if (!CONFIG.MUNI_ENABLED || !CONFIG.MUNI_API_KEY || !CONFIG.MUNI_STOP_CODE || !CONFIG.MUNI_ROUTE) {
-    console.log('MUNI tracking disabled or not configured');
+  var routes = getMuniRoutes();
+  if (!watchHas('MUNI') || !CONFIG.MUNI_ENABLED || (!CONFIG.MUNI_API_KEY && !CONFIG.MUNI_SCHEDULE_URL) ||
+      routes.length === 0) {
+    log(LOG.DEBUG, 'MUNI tracking disabled or not configured');
     callback(null);
     return;
   }
+  refreshMuniSchedule();
+
+  // Group routes by stop so shared stops cost a single request
+  var stops = [];
+  var routesByStop = {};
+  for (var i = 0; i < routes.length; i++) {
+    if (!routesByStop[routes[i].stop]) {
+      routesByStop[routes[i].stop] = [];
+      stops.push(routes[i].stop);
+    }
+    routesByStop[routes[i].stop].push(routes[i]);
+  }
+
+  var arrivalsByStop = {};
+  var completed = 0;
+  var oldestData = 0;
+
+  function stopComplete(stop, arrivals) {
+    arrivalsByStop[stop] = arrivals;
+    completed++;
+    if (completed < stops.length) {
+      return;
+    }
+
+    var now = Math.floor(Date.now() / 1000);
+    var scheduleIndex = loadMuniSchedule();
+    var table = [];
+    for (var j = 0; j < routes.length; j++) {
+      var stopArrivals = arrivalsByStop[routes[j].stop];
+      var key = routes[j].route + '/' + routes[j].direction;
+      var timestamps = ((stopArrivals && stopArrivals[key]) || []).filter(function(t) {
+        return t > now;  // Cached predictions may have run out
+      });
+      var scheduled = false;
+      if (timestamps.length === 0 && scheduleIndex) {
+        timestamps = schedule.scheduledArrivals(scheduleIndex, routes[j].stop, routes[j].route,
+                                                routes[j].direction, Date.now(), MUNI_MAX_ARRIVALS)
+          .filter(function(t) {
+            return t - now <= MUNI_SCHEDULE_HORIZON;
+          });
+        scheduled = timestamps.length > 0;
+      }
+
+      // The group is only as fresh as its oldest stop; a schedule lookup is current
+      var dataTime = scheduled ? now : providerDataTime['muni_' + routes[j].stop] || 0;
+      if (j === 0 || dataTime < oldestData) {
+        oldestData = dataTime;
+      }
+      table.push({
+        route: routes[j].route,
+        timestamps: timestamps,
+        scheduled: scheduled
+      });
+    }
+    providerDataTime.muni = oldestData;
+    callback(table);
+  }
+
+  for (var k = 0; k < stops.length; k++) {
+    if (CONFIG.MUNI_API_KEY) {
+      fetchMuniStop(stops[k], routesByStop[stops[k]], stopComplete);
+    } else {
+      stopComplete(stops[k], null);
+    }
+  }
+}
+
+// Cached schedule index for the configured URL (null = none)
+function loadMuniSchedule() {
+  var stored = localStorage.getItem('fitzface_muni_schedule');
+  if (!stored || !CONFIG.MUNI_SCHEDULE_URL) {
+    return null;
+  }
+  try {
+    var cached = JSON.parse(stored);
+    return cached.url === CONFIG.MUNI_SCHEDULE_URL && schedule.validIndex(cached.index) ? cached.index : null;
+  } catch (e) {
+    log(LOG.WARN, 'Error loading MUNI schedule: ' + e);
+    return null;
+  }
+}
+
+// Download the schedule index in the background when it is missing, for another
+// URL or a week old. The current sync keeps using what is cached.
+function refreshMuniSchedule() {
+  if (!CONFIG.MUNI_SCHEDULE_URL) {
+    return;
+  }
+  var stored = localStorage.getItem('fitzface_muni_schedule');
+  var cached = null;
+  try {
+    cached = stored ? JSON.parse(stored) : null;
+  } catch (e) {
+    cached = null;
+  }
+  if (cached && cached.url === CONFIG.MUNI_SCHEDULE_URL && Date.now() - cached.fetched < MUNI_SCHEDULE_MAX_AGE) {
+    return;
+  }
+  if (!providerAllowed('muni_schedule')) {
+    return;
+  }
+
+  log(LOG.DEBUG, 'Downloading MUNI schedule index...');
+  var xhr = new XMLHttpRequest();
+  xhr.open('GET', providerUrl(CONFIG.MUNI_SCHEDULE_URL), true);
+  xhr.timeout = 30000;
+
+  xhr.onload = function() {
+    if (xhr.readyState === 4) {
+      if (xhr.status === 200) {
+        try {
+          var index = JSON.parse(xhr.responseText);
+          if (!schedule.validIndex(index)) {
+            throw new Error('not a schedule index');
+          }
+          localStorage.setItem('fitzface_muni_schedule', JSON.stringify({
+            url: CONFIG.MUNI_SCHEDULE_URL,
+            fetched: Date.now(),
+            index: index
+          }));
+          providerSucceeded('muni_schedule', null);
+          log(LOG.INFO, 'MUNI schedule cached for ' + Object.keys(index.stops).length + ' stop(s)');
+        } catch (e) {
+          log(LOG.WARN, 'Error parsing MUNI schedule: ' + e);
+          providerFailed('muni_schedule');
+        }
+      } else {
+        log(LOG.WARN, 'MUNI schedule request failed: ' + xhr.status);
+        providerFailed('muni_schedule');
+      }
+    }
+  };
 
+  xhr.onerror = function() {
+    log(LOG.WARN, 'MUNI schedule request error');
+    providerFailed('muni_schedule');
+  };
+
+  xhr.ontimeout = function() {
+    log(LOG.WARN, 'MUNI schedule request timeout');
+    providerFailed('muni_schedule');
+  };
+
+  xhr.send();
+}
+
+// Fetch StopMonitoring for one stop; calls back with { 'ROUTE/DIR': [timestamps] }
+function fetchMuniStop(stop, routes, callback) {
+  var provider = 'muni_' + stop;
   var url = 'http://api.511.org/transit/StopMonitoring?' +
     'api_key=' + encodeURIComponent(CONFIG.MUNI_API_KEY) +
     '&agency=SF' +
-    '&stopCode=' + encodeURIComponent(CONFIG.MUNI_STOP_CODE) +
+    '&stopCode=' + encodeURIComponent(stop) +
     '&format=json';
 
-  console.log('Fetching MUNI predictions for route ' + CONFIG.MUNI_ROUTE + ' at stop ' + CONFIG.MUNI_STOP_CODE);
+  if (!providerAllowed(provider)) {
+    callback(stop, cachedProviderData(provider));
+    return;
+  }
+
+  log(LOG.DEBUG, 'Fetching MUNI predictions for ' + routes.length + ' route(s) at stop ' + stop);
 
   var xhr = new XMLHttpRequest();
-  xhr.open('GET', url, true);
+  xhr.open('GET', providerUrl(url), true);
   xhr.timeout = 10000;
 
   xhr.onload = function() {
@@ -367,46 +1291,52 @@ function fetchMuniBusPredictions(callback) {
       if (xhr.status === 200) {
         try {
           var response = JSON.parse(xhr.responseText);
-          var arrivals = parseMuniPredictions(response);
-          console.log('MUNI predictions received: ' + JSON.stringify(arrivals));
-          callback(arrivals);
+          var arrivals = {};
+          for (var i = 0; i < routes.length; i++) {
+            var timestamps = parseMuniPredictions(response, routes[i].route, routes[i].direction);
+            arrivals[routes[i].route + '/' + routes[i].direction] = timestamps || [];
+          }
+          if (logEnabled(LOG.DEBUG)) {
+            log(LOG.DEBUG, 'MUNI predictions received: ' + JSON.stringify(arrivals));
+          }
+          providerSucceeded(provider, arrivals);
+          callback(stop, arrivals);
         } catch (e) {
-          console.log('Error parsing MUNI response: ' + e);
-          callback(null);
+          log(LOG.WARN, 'Error parsing MUNI response: ' + e);
+          callback(stop, providerFailed(provider));
         }
       } else {
-        console.log('MUNI request failed: ' + xhr.status + ' - ' + xhr.responseText);
-        callback(null);
+        log(LOG.WARN, 'MUNI request failed: ' + xhr.status);
+        callback(stop, providerFailed(provider));
       }
     }
   };
 
   xhr.onerror = function() {
-    console.log('MUNI request error');
-    callback(null);
+    log(LOG.WARN, 'MUNI request error');
+    callback(stop, providerFailed(provider));
   };
 
   xhr.ontimeout = function() {
-    console.log('MUNI request timeout');
-    callback(null);
+    log(LOG.WARN, 'MUNI request timeout');
+    callback(stop, providerFailed(provider));
   };
 
   xhr.send();
 }
 
-// Parse MUNI 511.org API response
-function parseMuniPredictions(response) {
+// Parse MUNI 511.org API response for one route and direction
+// Returns up to MUNI_MAX_ARRIVALS Unix timestamps, or null if none match
+function parseMuniPredictions(response, targetRoute, targetDirection) {
   try {
     var visits = response.ServiceDelivery.StopMonitoringDelivery.MonitoredStopVisit;
     if (!visits || visits.length === 0) {
-      console.log('No MUNI predictions available');
+      log(LOG.DEBUG, 'No MUNI predictions available');
       return null;
     }
 
     var responseTime = new Date(response.ServiceDelivery.ResponseTimestamp);
     var arrivals = [];
-    var targetRoute = CONFIG.MUNI_ROUTE.toUpperCase();
-    var targetDirection = CONFIG.MUNI_DIRECTION || 'IB';
 
     // Filter by route and direction, store timestamps for next 40 minutes
     for (var i = 0; i < visits.length; i++) {
@@ -439,15 +1369,17 @@ function parseMuniPredictions(response) {
     arrivals.sort(function(a, b) { return a.timestamp - b.timestamp; });
 
     if (arrivals.length === 0) {
-      console.log('No matching MUNI arrivals found for ' + targetRoute + ' ' + targetDirection);
+      log(LOG.DEBUG, 'No matching MUNI arrivals found for ' + targetRoute + ' ' + targetDirection);
       return null;
     }
 
-    console.log('Found ' + arrivals.length + ' MUNI arrivals in next 40min: ' +
-                arrivals.map(function(a) { return a.minutes + 'min'; }).join(', '));
+    if (logEnabled(LOG.DEBUG)) {
+      log(LOG.DEBUG, 'Found ' + arrivals.length + ' MUNI arrivals in next 40min for ' + targetRoute + ': ' +
+                     arrivals.map(function(a) { return a.minutes + 'min'; }).join(', '));
+    }
 
-    // Extrapolate additional timestamps if we have fewer than 6
-    if (arrivals.length >= 2 && arrivals.length < 6) {
+    // Extrapolate additional timestamps if we have fewer than MUNI_MAX_ARRIVALS
+    if (arrivals.length >= 2 && arrivals.length < MUNI_MAX_ARRIVALS) {
       // Calculate average interval between buses (in seconds)
       var totalInterval = 0;
       for (var i = 1; i < arrivals.length; i++) {
@@ -455,44 +1387,191 @@ function parseMuniPredictions(response) {
       }
       var avgInterval = Math.round(totalInterval / (arrivals.length - 1));
 
-      console.log('Extrapolating with avg interval: ' + Math.round(avgInterval/60) + ' min');
+      log(LOG.DEBUG, 'Extrapolating with avg interval: ' + Math.round(avgInterval/60) + ' min');
 
-      // Extrapolate up to 6 total timestamps
       var lastTimestamp = arrivals[arrivals.length - 1].timestamp;
-      while (arrivals.length < 6) {
+      while (arrivals.length < MUNI_MAX_ARRIVALS) {
         lastTimestamp += avgInterval;
         arrivals.push({ timestamp: lastTimestamp, minutes: -1 });
       }
 
-      console.log('After extrapolation: ' + arrivals.length + ' timestamps');
+      log(LOG.DEBUG, 'After extrapolation: ' + arrivals.length + ' timestamps');
     }
 
     // Return up to 6 timestamps (enough for 30-min sync window at 6-min frequency)
-    return {
-      timestamp1: arrivals[0] ? arrivals[0].timestamp : 0,
-      timestamp2: arrivals[1] ? arrivals[1].timestamp : 0,
-      timestamp3: arrivals[2] ? arrivals[2].timestamp : 0,
-      timestamp4: arrivals[3] ? arrivals[3].timestamp : 0,
-      timestamp5: arrivals[4] ? arrivals[4].timestamp : 0,
-      timestamp6: arrivals[5] ? arrivals[5].timestamp : 0
-    };
+    return arrivals.slice(0, MUNI_MAX_ARRIVALS).map(function(a) { return a.timestamp; });
   } catch (e) {
-    console.log('Error parsing MUNI predictions: ' + e);
+    log(LOG.WARN, 'Error parsing MUNI predictions: ' + e);
     return null;
   }
 }
 
+// Pack the MUNI table into the MUNI_TABLE byte array:
+//   [0-3]  base Unix time (uint32, little endian)
+//   [4]    route count
+//   then per route: label (4 bytes, zero padded, MUNI_ROUTE_SCHEDULED set on the
+//   first byte for scheduled arrivals) + MUNI_MAX_ARRIVALS uint16 offsets in
+//   seconds from the base time (0 = no arrival)
+function packMuniTable(table) {
+  var bytes = [0, 0, 0, 0, 0];
+  if (!table || table.length === 0) {
+    return bytes;
+  }
+
+  var base = Math.floor(Date.now() / 1000);
+  bytes[0] = base & 0xFF;
+  bytes[1] = (base >>> 8) & 0xFF;
+  bytes[2] = (base >>> 16) & 0xFF;
+  bytes[3] = (base >>> 24) & 0xFF;
+  bytes[4] = table.length;
+
+  for (var i = 0; i < table.length; i++) {
+    for (var c = 0; c < 4; c++) {
+      bytes.push(c < table[i].route.length ? table[i].route.charCodeAt(c) & 0x7F : 0);
+    }
+    if (table[i].scheduled) {
+      bytes[bytes.length - 4] |= MUNI_ROUTE_SCHEDULED;
+    }
+    for (var j = 0; j < MUNI_MAX_ARRIVALS; j++) {
+      var offset = 0;
+      if (j < table[i].timestamps.length) {
+        offset = Math.max(0, Math.min(0xFFFF, table[i].timestamps[j] - base));
+      }
+      bytes.push(offset & 0xFF, (offset >>> 8) & 0xFF);
+    }
+  }
+  return bytes;
+}
+
+// Pack upcoming tides into the TIDE_TABLE byte array:
+//   [0-3]  base Unix time (uint32, little endian)
+//   [4]    tide count
+//   then per tide: uint16 minutes from the base time, type (1 = high, 0 = low)
+//   and int16 height in tenths of a foot above MLLW
+function packTideTable(predictions) {
+  var base = Math.floor(Date.now() / 1000);
+  var bytes = [base & 0xFF, (base >>> 8) & 0xFF, (base >>> 16) & 0xFF, (base >>> 24) & 0xFF, 0];
+
+  for (var i = 0; i < predictions.length && i < TIDE_TABLE_MAX; i++) {
+    var minutes = Math.max(0, Math.min(0xFFFF, Math.round((parseTideTime(predictions[i].t) - base) / 60)));
+    var height = Math.round(parseFloat(predictions[i].v) * 10) & 0xFFFF;
+    bytes.push(minutes & 0xFF, (minutes >>> 8) & 0xFF, predictions[i].type === 'H' ? 1 : 0,
+               height & 0xFF, (height >>> 8) & 0xFF);
+    bytes[4]++;
+  }
+  return bytes;
+}
+
+// Pack the hourly precipitation probability into the PRECIP_HOURLY byte array:
+//   [0-3]  Unix time of the first hour (uint32, little endian)
+//   then one byte per hour (0-100%), up to PRECIP_HOURS
+function packPrecipHourly(hourly) {
+  var start = Math.floor(new Date(hourly.time[0]).getTime() / 1000);
+  var bytes = [start & 0xFF, (start >>> 8) & 0xFF, (start >>> 16) & 0xFF, (start >>> 24) & 0xFF];
+  for (var i = 0; i < PRECIP_HOURS && i < hourly.precipitation_probability.length; i++) {
+    bytes.push(Math.max(0, Math.min(100, Math.round(hourly.precipitation_probability[i] || 0))));
+  }
+  return bytes;
+}
+
+// Pack the 15-minute precipitation nowcast into the NOWCAST byte array:
+//   [0-3]  Unix time the first slot starts (uint32, little endian)
+//   [4]    slot count (up to NOWCAST_SLOTS, 0 = no nowcast)
+//   then 2 bits per slot, four slots per byte from the low bits: 0 = dry,
+//   1 = light, 2 = moderate, 3 = heavy (NOWCAST_LEVELS)
+// Open-Meteo's minutely_15 values are the precipitation of the 15 minutes
+// before each time, so slot i starts one slot before time[i].
+function packNowcast(minutely) {
+  if (!minutely || !minutely.time || minutely.time.length === 0 || !minutely.precipitation) {
+    return [0, 0, 0, 0, 0];
+  }
+  var start = Math.floor(new Date(minutely.time[0]).getTime() / 1000) - NOWCAST_SLOT_SECONDS;
+  var count = Math.min(NOWCAST_SLOTS, minutely.time.length, minutely.precipitation.length);
+  var bytes = [start & 0xFF, (start >>> 8) & 0xFF, (start >>> 16) & 0xFF, (start >>> 24) & 0xFF, count];
+  for (var i = 0; i < count; i++) {
+    var level = 0;
+    while (level < NOWCAST_LEVELS.length && minutely.precipitation[i] >= NOWCAST_LEVELS[level]) {
+      level++;
+    }
+    if (i % 4 === 0) {
+      bytes.push(0);
+    }
+    bytes[bytes.length - 1] |= level << ((i % 4) * 2);
+  }
+  return bytes;
+}
+
+// Unix time of local midnight today
+function startOfToday() {
+  var now = new Date();
+  return new Date(now.getFullYear(), now.getMonth(), now.getDate()).getTime() / 1000;
+}
+
+// Unix time of local midnight on a "YYYY-MM-DD" date
+function parseLocalDate(dateStr) {
+  var parts = dateStr.split('-');
+  return new Date(parseInt(parts[0], 10), parseInt(parts[1], 10) - 1, parseInt(parts[2], 10)).getTime() / 1000;
+}
+
+// Header shared by the day tables:
+//   [0-3]  Unix time of local midnight on the first day (uint32, little endian)
+//   [4]    day count (up to FORECAST_DAYS)
+function packDayTableHeader(start, count) {
+  return [start & 0xFF, (start >>> 8) & 0xFF, (start >>> 16) & 0xFF, (start >>> 24) & 0xFF,
+          Math.min(count, FORECAST_DAYS)];
+}
+
+function clampByte(value, min, max) {
+  return Math.max(min, Math.min(max, Math.round(value || 0))) & 0xFF;
+}
+
+// Degrees Celsius as little-endian int16 tenths
+function tenthsBytes(celsius) {
+  var tenths = Math.max(-32768, Math.min(32767, Math.round((celsius || 0) * 10))) & 0xFFFF;
+  return [tenths & 0xFF, (tenths >>> 8) & 0xFF];
+}
+
+// Pack Open-Meteo's daily arrays into the DAILY_WEATHER byte array: the day table
+// header, then per day weather code, int16 low and high temperature (tenths of a
+// degree Celsius), precipitation probability max (0-100%) and UV index max
+function packDailyWeather(daily) {
+  var count = Math.min(daily.time.length, FORECAST_DAYS);
+  var bytes = packDayTableHeader(parseLocalDate(daily.time[0]), count);
+  for (var i = 0; i < count; i++) {
+    bytes.push(clampByte(daily.weather_code[i], 0, 255));
+    bytes.push.apply(bytes, tenthsBytes(daily.temperature_2m_min[i]));
+    bytes.push.apply(bytes, tenthsBytes(daily.temperature_2m_max[i]));
+    bytes.push(clampByte(daily.precipitation_probability_max[i], 0, 100),
+               clampByte(daily.uv_index_max[i], 0, 255));
+  }
+  return bytes;
+}
+
+// Pack pollen levels into the DAILY_POLLEN byte array: the day table header, then
+// per day int8 tree, grass and weed index (0-5, -1 = no data). Zero days = no data.
+function packDailyPollen(pollenData) {
+  if (!pollenData) {
+    return packDayTableHeader(0, 0);
+  }
+  var days = pollenData.days || [pollenData];  // Caches from before multi-day pollen
+  var bytes = packDayTableHeader(pollenData.start || startOfToday(), days.length);
+  for (var i = 0; i < days.length && i < FORECAST_DAYS; i++) {
+    bytes.push(clampByte(days[i].tree, -1, 5), clampByte(days[i].grass, -1, 5), clampByte(days[i].weed, -1, 5));
+  }
+  return bytes;
+}
+
 // Fetch pollen data from Google Pollen API
 function fetchPollen(location, callback) {
-  if (!CONFIG.POLLEN_ENABLED || !CONFIG.POLLEN_API_KEY) {
-    console.log('Pollen disabled or no API key');
+  if (!watchHas('POLLEN') || !CONFIG.POLLEN_ENABLED || !CONFIG.POLLEN_API_KEY) {
+    log(LOG.DEBUG, 'Pollen disabled or no API key');
     callback(null);
     return;
   }
 
   var apiKey = CONFIG.POLLEN_API_KEY.trim();
   if (!apiKey) {
-    console.log('Pollen API key is empty');
+    log(LOG.DEBUG, 'Pollen API key is empty');
     callback(null);
     return;
   }
@@ -501,12 +1580,18 @@ function fetchPollen(location, callback) {
     'key=' + apiKey +
     '&location.latitude=' + location.lat +
     '&location.longitude=' + location.lon +
-    '&days=1';
+    '&days=' + FORECAST_DAYS;
+  var provider = locationProvider('pollen', location);
+
+  if (!providerAllowed(provider)) {
+    callback(cachedProviderData(provider, location));
+    return;
+  }
 
-  console.log('Fetching pollen data from Google Pollen API...');
+  log(LOG.DEBUG, 'Fetching pollen data from Google Pollen API...');
 
   var xhr = new XMLHttpRequest();
-  xhr.open('GET', url, true);
+  xhr.open('GET', providerUrl(url), true);
   xhr.timeout = 10000;
 
   xhr.onload = function() {
@@ -515,143 +1600,241 @@ function fetchPollen(location, callback) {
         try {
           var response = JSON.parse(xhr.responseText);
           var pollenData = parsePollenResponse(response);
-          console.log('Pollen data received: ' + JSON.stringify(pollenData));
+          if (logEnabled(LOG.DEBUG)) {
+            log(LOG.DEBUG, 'Pollen data received: ' + JSON.stringify(pollenData));
+          }
+          providerSucceeded(provider, pollenData, location);
           callback(pollenData);
         } catch (e) {
-          console.log('Error parsing pollen response: ' + e);
-          callback(null);
+          log(LOG.WARN, 'Error parsing pollen response: ' + e);
+          callback(providerFailed(provider, location));
         }
       } else {
-        console.log('Pollen request failed: ' + xhr.status);
-        callback(null);
+        log(LOG.WARN, 'Pollen request failed: ' + xhr.status);
+        callback(providerFailed(provider, location));
       }
     }
   };
 
   xhr.onerror = function() {
-    console.log('Pollen request error');
-    callback(null);
+    log(LOG.WARN, 'Pollen request error');
+    callback(providerFailed(provider, location));
   };
 
   xhr.ontimeout = function() {
-    console.log('Pollen request timeout');
-    callback(null);
+    log(LOG.WARN, 'Pollen request timeout');
+    callback(providerFailed(provider, location));
   };
 
   xhr.send();
 }
 
-// Parse Google Pollen API response
+// Pollen indices (0-5) for one day of a Google Pollen API response (-1 = no data)
+function parsePollenDay(day) {
+  var levels = { tree: -1, grass: -1, weed: -1 };
+  if (!day.pollenTypeInfo) {
+    return levels;
+  }
+
+  levels.tree = levels.grass = levels.weed = 0;
+  for (var i = 0; i < day.pollenTypeInfo.length; i++) {
+    var pollenType = day.pollenTypeInfo[i];
+    var value = pollenType.indexInfo ? pollenType.indexInfo.value : 0;
+
+    if (pollenType.code === 'TREE') {
+      levels.tree = value;
+    } else if (pollenType.code === 'GRASS') {
+      levels.grass = value;
+    } else if (pollenType.code === 'WEED') {
+      levels.weed = value;
+    }
+  }
+  return levels;
+}
+
+// Parse Google Pollen API response. tree/grass/weed are today's levels (used by
+// the alerts), days holds every forecast day starting at start (local midnight).
 function parsePollenResponse(response) {
   try {
     if (!response.dailyInfo || response.dailyInfo.length === 0) {
-      console.log('No pollen data available');
+      log(LOG.DEBUG, 'No pollen data available');
       return null;
     }
 
-    var today = response.dailyInfo[0];
-    if (!today.pollenTypeInfo) {
-      console.log('No pollen type info');
+    var first = response.dailyInfo[0];
+    if (!first.pollenTypeInfo) {
+      log(LOG.DEBUG, 'No pollen type info');
       return null;
     }
 
-    var tree = 0, grass = 0, weed = 0;
-
-    // Extract pollen indices for each type
-    for (var i = 0; i < today.pollenTypeInfo.length; i++) {
-      var pollenType = today.pollenTypeInfo[i];
-      var value = pollenType.indexInfo ? pollenType.indexInfo.value : 0;
-
-      if (pollenType.code === 'TREE') {
-        tree = value;
-      } else if (pollenType.code === 'GRASS') {
-        grass = value;
-      } else if (pollenType.code === 'WEED') {
-        weed = value;
-      }
+    var days = [];
+    for (var i = 0; i < response.dailyInfo.length && i < FORECAST_DAYS; i++) {
+      days.push(parsePollenDay(response.dailyInfo[i]));
     }
+    var today = days[0];
+    var start = first.date ?
+      new Date(first.date.year, first.date.month - 1, first.date.day).getTime() / 1000 : startOfToday();
 
-    console.log('Parsed pollen: Tree=' + tree + ', Grass=' + grass + ', Weed=' + weed);
+    log(LOG.DEBUG, 'Parsed pollen: Tree=' + today.tree + ', Grass=' + today.grass + ', Weed=' + today.weed +
+                   ' (' + days.length + ' days)');
 
     return {
-      tree: tree,
-      grass: grass,
-      weed: weed
+      tree: today.tree,
+      grass: today.grass,
+      weed: today.weed,
+      start: start,
+      days: days
     };
   } catch (e) {
-    console.log('Error parsing pollen data: ' + e);
+    log(LOG.WARN, 'Error parsing pollen data: ' + e);
     return null;
   }
 }
 
-// Fetch all data and send to watch
-function updateWeather() {
-  console.log('Starting weather update...');
-
-  getLocation(function(location) {
-    if (!location) {
-      console.log('Failed to get location');
+// Fetch data and send to watch. requested is the watch's REFRESH_SOURCES mask
+// (undefined = every source the power profile allows).
+function updateWeather(requested) {
+  var sources = syncSources(requested);
+  log(LOG.INFO, 'Starting weather update: ' + Object.keys(sources).filter(function(name) {
+    return sources[name];
+  }).join(', '));
+  providerDataTime = {};
+  var syncStarted = Math.floor(Date.now() / 1000);
+
+  // Tides and MUNI don't depend on where the wearer is - skip the fix without them
+  var needsLocation = sources.weather || sources.aqi || sources.pollen || sources.daily || sources.location;
+  var locate = needsLocation ? getLocation : function(callback) { callback(null); };
+
+  locate(function(location) {
+    if (needsLocation && !location) {
+      log(LOG.WARN, 'Failed to get location');
       return;
     }
 
-    // Fetch weather, AQI, tides, MUNI, and pollen in parallel
+    // Arriving at a saved place: show its cached snapshot while the fetch runs
+    var place = location ? findSavedPlace(location) : null;
+    if (place && place.name !== currentPlace) {
+      sendPlaceSnapshot(place);
+    }
+    if (location) {
+      currentPlace = place ? place.name : null;
+    }
+
+    // Fetch the requested sources in parallel
     var weatherData = null;
     var aqiData = null;
     var tideData = null;
     var muniData = null;
     var pollenData = null;
+    var dailyData = null;
     var completed = 0;
-    var total = 5;
+    var total = 6;
 
     function checkComplete() {
       completed++;
       if (completed === total) {
-        sendDataToWatch(location, weatherData, aqiData, tideData, muniData, pollenData);
+        // Refresh the place's snapshot with data fetched by this sync (not cached fallbacks)
+        if (place && weatherData && providerDataTime.weather >= syncStarted) {
+          var previous = loadPlaceSnapshot(place);
+          savePlaceSnapshot(place, {
+            time: providerDataTime.weather,
+            weather: weatherData,
+            aqi: aqiData,
+            pollen: pollenData,
+            daily: dailyData || (previous && previous.daily) || null  // Daily is fetched once a day
+          });
+        }
+        // Capture this sync's data times before the prefetch starts more fetches
+        var dataTime = {};
+        for (var provider in providerDataTime) {
+          dataTime[provider] = providerDataTime[provider];
+        }
+        sendDataToWatch(location, weatherData, aqiData, tideData, muniData, pollenData, dailyData, sources,
+                        dataTime);
+        if (sources.weather && !isReducedPowerProfile()) {
+          prefetchSavedPlaces(place);
+        }
       }
     }
 
-    // Fetch weather
-    fetchWeather(location, function(err, data) {
-      if (!err && data) {
-        weatherData = data;
+    // Run a fetch only if its source is part of this sync
+    function fetchSource(name, fetch) {
+      if (sources[name]) {
+        fetch();
+      } else {
+        log(LOG.DEBUG, 'Skipping ' + name + ' (not requested)');
+        checkComplete();
       }
-      checkComplete();
+    }
+
+    // Fetch weather
+    fetchSource('weather', function() {
+      fetchWeather(location, function(err, data) {
+        if (!err && data) {
+          weatherData = data;
+        }
+        checkComplete();
+      });
     });
 
     // Fetch AQI
-    fetchAQI(location, function(err, data) {
-      if (!err && data) {
-        aqiData = data;
-      }
-      checkComplete();
+    fetchSource('aqi', function() {
+      fetchAQI(location, function(err, data) {
+        if (!err && data) {
+          aqiData = data;
+        }
+        checkComplete();
+      });
     });
 
     // Fetch tides
-    fetchTides(function(err, data) {
-      if (!err) {
-        tideData = data;
-      }
-      checkComplete();
+    fetchSource('tide', function() {
+      fetchTides(location, function(err, data) {
+        if (!err) {
+          tideData = data;
+        }
+        checkComplete();
+      });
     });
 
     // Fetch MUNI predictions
-    fetchMuniBusPredictions(function(data) {
-      if (data) {
-        muniData = data;
-      }
-      checkComplete();
+    fetchSource('muni', function() {
+      fetchMuniBusPredictions(function(data) {
+        if (data) {
+          muniData = data;
+        }
+        checkComplete();
+      });
     });
 
     // Fetch pollen data
-    fetchPollen(location, function(data) {
-      if (data) {
-        pollenData = data;
-      }
-      checkComplete();
+    fetchSource('pollen', function() {
+      fetchPollen(location, function(data) {
+        if (data) {
+          pollenData = data;
+        }
+        checkComplete();
+      });
+    });
+
+    // Fetch the multi-day forecast
+    fetchSource('daily', function() {
+      fetchDailyForecast(location, function(err, data) {
+        if (!err && data) {
+          dailyData = data;
+        }
+        checkComplete();
+      });
     });
   });
 }
 
+// Wind speed (m/s) in the configured unit, e.g. "25mph"
+function formatWindSpeed(speed) {
+  var unit = WIND_UNITS[CONFIG.WIND_UNIT] || WIND_UNITS.mph;
+  return Math.round(speed * unit.perMs) + unit.label;
+}
+
 // Detect weather alerts from hourly forecast data
 function detectWeatherAlerts(weatherData, aqiData, pollenData) {
   if (!weatherData || !weatherData.hourly) {
@@ -729,10 +1912,10 @@ function detectWeatherAlerts(weatherData, aqiData, pollenData) {
     }
 
     // Priority 6: High wind gusts (≥20mph)
-    if (windGust >= 20) {
+    if (windGust >= WIND_ALERT_GUST) {
       alerts.push({
         priority: 6,
-        text: 'Wind ' + Math.round(windGust) + 'mph',
+        text: 'Wind ' + formatWindSpeed(windGust),
         startHour: hour
       });
     }
@@ -815,7 +1998,7 @@ function detectWeatherAlerts(weatherData, aqiData, pollenData) {
   // Build alert message
   var alertText = topAlert.text + ' ' + timeRange;
 
-  console.log('Weather alert detected: ' + alertText);
+  log(LOG.INFO, 'Weather alert detected: ' + alertText);
 
   return {
     active: true,
@@ -823,6 +2006,16 @@ function detectWeatherAlerts(weatherData, aqiData, pollenData) {
   };
 }
 
+// Fetch time reported to the watch for a data group, from the sync's captured
+// data times. Disabled groups have nothing to fetch, so they are reported as
+// fresh to keep the watch from requesting them.
+function groupUpdateTime(dataTime, provider, enabled, now) {
+  if (!enabled) {
+    return now;
+  }
+  return dataTime[provider] || 0;
+}
+
 // Format hour for display (e.g., "3PM", "11AM")
 function formatHour(date) {
   var hours = date.getHours();
@@ -833,15 +2026,164 @@ function formatHour(date) {
 }
 
 // Send data to watch via AppMessage
-function sendDataToWatch(location, weatherData, aqiData, tideData, muniData, pollenData) {
-  console.log('Preparing data to send to watch...');
+function sendDataToWatch(location, weatherData, aqiData, tideData, muniData, pollenData, dailyData, sources,
+                         dataTime) {
+  log(LOG.DEBUG, 'Preparing data to send to watch...');
+
+  var message = {};
+  addWeatherFields(message, weatherData, aqiData, pollenData, dailyData);
+  if (location) {
+    addCoordinates(message, location);
+  }
+  if (!sources.weather) {
+    // Alerts need the forecast - keep the watch's current alert
+    delete message.ALERT_ACTIVE;
+    delete message.ALERT_TEXT;
+  }
+  if (!sources.pollen) {
+    // Not fetched this sync - keep the watch's pollen days
+    delete message.DAILY_POLLEN;
+  }
+
+  // Tide data (next tide for the grid, upcoming tides for the detail page)
+  if (tideData) {
+    message.TIDE_NEXT_TIME = parseTideTime(tideData[0].t);
+    message.TIDE_NEXT_TYPE = tideData[0].type === 'H' ? 1 : 0; // 1 = high, 0 = low
+    message.TIDE_NEXT_HEIGHT = Math.round(parseFloat(tideData[0].v) * 10) / 10;
+    message.TIDE_TABLE = packTideTable(tideData);
+  }
+
+  // Location name (only looked up when the location group was requested)
+  var lookupName = sources.location ? getLocationName : function(point, callback) { callback(null); };
+  lookupName(location, function(name) {
+    if (name !== null) {
+      message.LOCATION_NAME = name;
+    }
+
+    // Freshness: when each group's data was fetched (0 = no data this sync)
+    var now = Math.floor(Date.now() / 1000);
+    message.LAST_UPDATE = now;
+    message.UPDATED_WEATHER = sources.weather ? groupUpdateTime(dataTime, 'weather', true, now) : 0;
+    if (watchHas('AQI')) {
+      message.UPDATED_AQI = sources.aqi ? groupUpdateTime(dataTime, 'aqi', CONFIG.SHOW_AQI, now) : 0;
+    }
+    if (watchHas('TIDE')) {
+      message.UPDATED_TIDE = sources.tide ?
+        groupUpdateTime(dataTime, 'tide', CONFIG.SHOW_TIDE, now) : 0;
+    }
+    if (watchHas('MUNI')) {
+      message.UPDATED_MUNI = sources.muni ? groupUpdateTime(dataTime, 'muni', CONFIG.MUNI_ENABLED &&
+                                                            (CONFIG.MUNI_API_KEY || CONFIG.MUNI_SCHEDULE_URL) &&
+                                                            getMuniRoutes().length > 0, now) : 0;
+    }
+    if (watchHas('POLLEN')) {
+      message.UPDATED_POLLEN = sources.pollen ?
+        groupUpdateTime(dataTime, 'pollen', CONFIG.POLLEN_ENABLED && CONFIG.POLLEN_API_KEY, now) : 0;
+    }
+    message.UPDATED_LOCATION = sources.location ? location.time || now : 0;
+    message.UPDATED_DAILY = sources.daily ? groupUpdateTime(dataTime, 'daily', true, now) : 0;
+
+    addConfigFields(message);
+
+    // MUNI data (per-route arrival table, zero routes indicates no data)
+    if (watchHas('MUNI') && sources.muni) {
+      message.MUNI_TABLE = packMuniTable(muniData);
+    }
+    if (muniData && logEnabled(LOG.DEBUG)) {
+      log(LOG.DEBUG, 'MUNI table sent: ' + muniData.map(function(r) {
+        return r.route + ' x' + r.timestamps.length;
+      }).join(', '));
+    }
+
+    // Send to watch
+    if (logEnabled(LOG.DEBUG)) {
+      log(LOG.DEBUG, 'Sending message to watch: ' + Object.keys(message).join(', '));  // Keys only
+    }
+    sendToWatch(message,
+      function(e) {
+        log(LOG.INFO, 'Message sent successfully');
+        coordinatesSent(message);
+      },
+      function(e) {
+        log(LOG.WARN, 'Error sending message: ' + JSON.stringify(e));
+      }
+    );
+  });
+}
+
+// Add the display configuration to a message
+function addConfigFields(message) {
+  message.CONFIG_TEMP_UNIT = CONFIG.TEMP_UNIT === 'C' ? 1 : 0;
+  message.CONFIG_WIND_UNIT = (WIND_UNITS[CONFIG.WIND_UNIT] || WIND_UNITS.mph).index;
+  if (watchHas('AQI')) {
+    message.CONFIG_SHOW_AQI = CONFIG.SHOW_AQI ? 1 : 0;
+  }
+  message.CONFIG_SHOW_UV = CONFIG.SHOW_UV ? 1 : 0;
+  message.CONFIG_SHOW_WIND = CONFIG.SHOW_WIND ? 1 : 0;
+  if (watchHas('TIDE')) {
+    message.CONFIG_SHOW_TIDE = CONFIG.SHOW_TIDE ? 1 : 0;
+  }
+  message.CONFIG_SHOW_SUNRISE = CONFIG.SHOW_SUNRISE ? 1 : 0;
+  if (watchHas('INVERT')) {
+    message.CONFIG_INVERT = CONFIG.INVERT ? 1 : 0;
+  }
+  message.CONFIG_QUIET_START = CONFIG.QUIET_START;
+  message.CONFIG_QUIET_END = CONFIG.QUIET_END;
+}
 
+// Send display settings without fetching anything. The alert text carries the
+// wind unit, so it is rebuilt from the cached forecast.
+function sendConfigToWatch() {
   var message = {};
+  addConfigFields(message);
+  var weatherData = cachedProviderData('weather', lastLocation);
+  if (watchHas('ALERTS') && weatherData) {
+    var alert = detectWeatherAlerts(weatherData, CONFIG.SHOW_AQI ? cachedProviderData('aqi', lastLocation) : null,
+                                    CONFIG.POLLEN_ENABLED ? cachedProviderData('pollen', lastLocation) : null);
+    message.ALERT_ACTIVE = alert.active ? 1 : 0;
+    message.ALERT_TEXT = alert.text || '';
+  }
+
+  sendToWatch(message,
+    function(e) {
+      log(LOG.INFO, 'Configuration sent');
+    },
+    function(e) {
+      log(LOG.WARN, 'Error sending configuration: ' + JSON.stringify(e));
+    }
+  );
+}
+
+// The settings that change what the companion fetches
+function fetchConfigKey() {
+  return JSON.stringify([CONFIG.TIDE_STATION, CONFIG.SHOW_AQI, CONFIG.SHOW_TIDE, CONFIG.MUNI_ENABLED,
+                         CONFIG.MUNI_API_KEY, CONFIG.MUNI_STOP_CODE, CONFIG.MUNI_ROUTE, CONFIG.MUNI_DIRECTION,
+                         CONFIG.MUNI_EXTRA_ROUTES, CONFIG.MUNI_SCHEDULE_URL, CONFIG.POLLEN_ENABLED,
+                         CONFIG.POLLEN_API_KEY, CONFIG.SAVED_PLACES]);
+}
+
+// Add coordinates (1e-4 degrees) for the watch to compute sunrise/sunset locally.
+// Skipped while the watch already has coordinates within COORDINATE_RESEND_DISTANCE.
+function addCoordinates(message, point) {
+  if (sentCoordinates && distanceMeters(sentCoordinates, point) < COORDINATE_RESEND_DISTANCE) {
+    return;
+  }
+  message.LATITUDE = Math.round(point.lat * 10000);
+  message.LONGITUDE = Math.round(point.lon * 10000);
+}
+
+function coordinatesSent(message) {
+  if (message.LATITUDE !== undefined) {
+    sentCoordinates = { lat: message.LATITUDE / 10000, lon: message.LONGITUDE / 10000 };
+  }
+}
 
+// Add location-dependent fields (weather, AQI, pollen, daily forecast and alerts) to a message
+function addWeatherFields(message, weatherData, aqiData, pollenData, dailyData) {
   // Weather data
   if (weatherData && weatherData.current) {
-    message.TEMPERATURE = Math.round(weatherData.current.temperature_2m);
-    message.WIND_SPEED = Math.round(weatherData.current.wind_speed_10m);
+    message.TEMPERATURE = Math.round(weatherData.current.temperature_2m * 10);
+    message.WIND_SPEED = Math.round(weatherData.current.wind_speed_10m * 10);
     message.UV_INDEX = Math.round(weatherData.current.uv_index || 0);
     message.WEATHER_CODE = weatherData.current.weather_code || 0;
   }
@@ -849,18 +2191,17 @@ function sendDataToWatch(location, weatherData, aqiData, tideData, muniData, pol
   // Current precipitation probability (from hourly data - use current or next hour)
   if (weatherData && weatherData.hourly && weatherData.hourly.precipitation_probability) {
     message.PRECIPITATION_PROBABILITY = weatherData.hourly.precipitation_probability[0] || 0;
+    message.PRECIP_HOURLY = packPrecipHourly(weatherData.hourly);
   }
 
-  if (weatherData && weatherData.daily) {
-    message.TEMP_MAX = Math.round(weatherData.daily.temperature_2m_max[0]);
-    message.TEMP_MIN = Math.round(weatherData.daily.temperature_2m_min[0]);
-    message.SUNRISE = parseISOTime(weatherData.daily.sunrise[0]);
-    message.SUNSET = parseISOTime(weatherData.daily.sunset[0]);
-    message.WIND_MAX = Math.round(weatherData.daily.wind_speed_10m_max[0]);
-    // Tomorrow's weather code (day 1)
-    if (weatherData.daily.weather_code && weatherData.daily.weather_code.length > 1) {
-      message.WEATHER_CODE_TOMORROW = weatherData.daily.weather_code[1] || 0;
-    }
+  // Precipitation nowcast (an empty one replaces a previous place's or an old cache's)
+  if (weatherData && weatherData.current) {
+    message.NOWCAST = packNowcast(weatherData.minutely_15);
+  }
+
+  // Multi-day forecast (today's high/low and tomorrow's icon come from day 0 and 1)
+  if (dailyData && dailyData.time && dailyData.time.length > 0) {
+    message.DAILY_WEATHER = packDailyWeather(dailyData);
   }
 
   // AQI data
@@ -868,114 +2209,533 @@ function sendDataToWatch(location, weatherData, aqiData, tideData, muniData, pol
     message.AQI = aqiData.aqi;
   }
 
-  // Tide data
-  if (tideData) {
-    message.TIDE_NEXT_TIME = parseTideTime(tideData.t);
-    message.TIDE_NEXT_TYPE = tideData.type === 'H' ? 1 : 0; // 1 = high, 0 = low
-    message.TIDE_NEXT_HEIGHT = Math.round(parseFloat(tideData.v) * 10) / 10;
+  // Weather alerts (includes UV, AQI, and pollen alerts)
+  if (watchHas('ALERTS')) {
+    var alert = detectWeatherAlerts(weatherData, aqiData, pollenData);
+    message.ALERT_ACTIVE = alert.active ? 1 : 0;
+    message.ALERT_TEXT = alert.text || '';
   }
 
-  // Weather alerts (includes UV, AQI, and pollen alerts)
-  var alert = detectWeatherAlerts(weatherData, aqiData, pollenData);
-  message.ALERT_ACTIVE = alert.active ? 1 : 0;
-  message.ALERT_TEXT = alert.text || '';
+  // Pollen days (an empty table indicates no data)
+  if (pollenData || watchHas('POLLEN')) {
+    message.DAILY_POLLEN = packDailyPollen(pollenData);
+  }
+}
 
-  // Location name
-  getLocationName(location, function(name) {
-    message.LOCATION_NAME = name;
+// Parse configured saved places ("Name@lat,lon; Name@lat,lon")
+function getSavedPlaces() {
+  var places = [];
+  var entries = (CONFIG.SAVED_PLACES || '').split(';');
 
-    // Configuration
-    message.CONFIG_TEMP_UNIT = CONFIG.TEMP_UNIT === 'C' ? 1 : 0;
-    message.CONFIG_SHOW_AQI = CONFIG.SHOW_AQI ? 1 : 0;
-    message.CONFIG_SHOW_UV = CONFIG.SHOW_UV ? 1 : 0;
-    message.CONFIG_SHOW_WIND = CONFIG.SHOW_WIND ? 1 : 0;
-    message.CONFIG_SHOW_TIDE = CONFIG.SHOW_TIDE ? 1 : 0;
-    message.CONFIG_SHOW_SUNRISE = CONFIG.SHOW_SUNRISE ? 1 : 0;
-    message.CONFIG_INVERT = CONFIG.INVERT ? 1 : 0;
+  for (var i = 0; i < entries.length && places.length < SAVED_PLACE_MAX; i++) {
+    var parts = entries[i].split('@');
+    if (parts.length !== 2) {
+      continue;
+    }
+    var coords = parts[1].split(',');
+    var lat = parseFloat(coords[0]);
+    var lon = parseFloat(coords[1]);
+    var name = parts[0].trim();
+    if (name && !isNaN(lat) && !isNaN(lon)) {
+      places.push({ name: name, lat: lat, lon: lon });
+    }
+  }
+  return places;
+}
 
-  // MUNI data (timestamps for next 6 buses)
-  if (muniData) {
-    message.MUNI_TIMESTAMP_1 = muniData.timestamp1;
-    message.MUNI_TIMESTAMP_2 = muniData.timestamp2;
-    message.MUNI_TIMESTAMP_3 = muniData.timestamp3;
-    message.MUNI_TIMESTAMP_4 = muniData.timestamp4;
-    message.MUNI_TIMESTAMP_5 = muniData.timestamp5;
-    message.MUNI_TIMESTAMP_6 = muniData.timestamp6;
-    console.log('MUNI timestamps sent: ' + [muniData.timestamp1, muniData.timestamp2,
-                muniData.timestamp3, muniData.timestamp4, muniData.timestamp5,
-                muniData.timestamp6].join(', '));
-  } else {
-    message.MUNI_TIMESTAMP_1 = 0;  // 0 indicates no data
-    message.MUNI_TIMESTAMP_2 = 0;
-    message.MUNI_TIMESTAMP_3 = 0;
-    message.MUNI_TIMESTAMP_4 = 0;
-    message.MUNI_TIMESTAMP_5 = 0;
-    message.MUNI_TIMESTAMP_6 = 0;
+// Great-circle distance between two coordinates in meters (haversine)
+function distanceMeters(a, b) {
+  var toRad = Math.PI / 180;
+  var dLat = (b.lat - a.lat) * toRad;
+  var dLon = (b.lon - a.lon) * toRad;
+  var h = Math.sin(dLat / 2) * Math.sin(dLat / 2) +
+          Math.cos(a.lat * toRad) * Math.cos(b.lat * toRad) *
+          Math.sin(dLon / 2) * Math.sin(dLon / 2);
+  return 6371000 * 2 * Math.atan2(Math.sqrt(h), Math.sqrt(1 - h));
+}
+
+// Find the saved place containing a location (null if none)
+function findSavedPlace(location) {
+  var places = getSavedPlaces();
+  for (var i = 0; i < places.length; i++) {
+    if (distanceMeters(location, places[i]) <= SAVED_PLACE_RADIUS) {
+      return places[i];
+    }
   }
+  return null;
+}
 
-  // Pollen data
-  if (pollenData) {
-    message.POLLEN_TREE = pollenData.tree;
-    message.POLLEN_GRASS = pollenData.grass;
-    message.POLLEN_WEED = pollenData.weed;
-    console.log('Pollen data added: Tree=' + pollenData.tree + ', Grass=' + pollenData.grass + ', Weed=' + pollenData.weed);
+function placeSnapshotKey(place) {
+  return 'fitzface_place_' + place.name + '@' + place.lat + ',' + place.lon;
+}
+
+function loadPlaceSnapshot(place) {
+  var stored = localStorage.getItem(placeSnapshotKey(place));
+  if (!stored) {
+    return null;
+  }
+  try {
+    return JSON.parse(stored);
+  } catch (e) {
+    log(LOG.WARN, 'Error loading snapshot for ' + place.name + ': ' + e);
+    return null;
+  }
+}
+
+function savePlaceSnapshot(place, snapshot) {
+  localStorage.setItem(placeSnapshotKey(place), JSON.stringify(snapshot));
+}
+
+// Send a saved place's cached weather to the watch without touching the network
+function sendPlaceSnapshot(place) {
+  var snapshot = loadPlaceSnapshot(place);
+  if (!snapshot) {
+    log(LOG.DEBUG, 'No snapshot cached for ' + place.name);
+    return;
+  }
+
+  log(LOG.INFO, 'Switching to cached snapshot for ' + place.name + ' (' +
+                Math.round((Date.now() / 1000 - snapshot.time) / 60) + ' min old)');
+
+  var message = {};
+  addWeatherFields(message, snapshot.weather, snapshot.aqi, snapshot.pollen, snapshot.daily);
+  addCoordinates(message, place);
+  message.LOCATION_NAME = place.name;
+  message.UPDATED_WEATHER = snapshot.time;
+  if (watchHas('AQI')) {
+    message.UPDATED_AQI = snapshot.time;
+  }
+  if (watchHas('POLLEN')) {
+    message.UPDATED_POLLEN = snapshot.time;
+  }
+  if (message.DAILY_WEATHER) {
+    message.UPDATED_DAILY = snapshot.time;
+  }
+  message.UPDATED_LOCATION = Math.floor(Date.now() / 1000);
+
+  sendToWatch(message,
+    function(e) {
+      log(LOG.INFO, 'Snapshot sent successfully');
+      coordinatesSent(message);
+    },
+    function(e) {
+      log(LOG.WARN, 'Error sending snapshot: ' + JSON.stringify(e));
+    }
+  );
+}
+
+// Refresh the oldest out-of-date snapshot of a saved place we are not at.
+// At most one place per sync keeps the background cost low.
+function prefetchSavedPlaces(currentPlaceInfo) {
+  var places = getSavedPlaces();
+  var target = null;
+  var targetTime = 0;
+
+  for (var i = 0; i < places.length; i++) {
+    if (currentPlaceInfo && places[i].name === currentPlaceInfo.name) {
+      continue;
+    }
+    var snapshot = loadPlaceSnapshot(places[i]);
+    var time = snapshot ? snapshot.time * 1000 : 0;
+    if (Date.now() - time >= SAVED_PLACE_PREFETCH_AGE && (!target || time < targetTime)) {
+      target = places[i];
+      targetTime = time;
+    }
+  }
+
+  if (!target) {
+    return;
+  }
+
+  // Skip while the weather provider is down for the wearer or for prefetches
+  var location = { lat: target.lat, lon: target.lon, prefetch: true };
+  if (getProviderHealth('weather').failures >= HEALTH_FAILURE_THRESHOLD ||
+      getProviderHealth(locationProvider('weather', location)).failures >= HEALTH_FAILURE_THRESHOLD) {
+    return;
+  }
+
+  log(LOG.DEBUG, 'Prefetching saved place ' + target.name);
+  var started = Math.floor(Date.now() / 1000);
+  var snapshot = { time: 0, weather: null, aqi: null, pollen: null, daily: null };
+  var completed = 0;
+
+  // Only keep data fetched just now (not a placeholder for a failed fetch)
+  function isFresh(provider) {
+    return (providerDataTime[locationProvider(provider, location)] || 0) >= started;
+  }
+
+  function checkComplete() {
+    completed++;
+    if (completed === 4 && snapshot.weather) {
+      snapshot.time = started;
+      savePlaceSnapshot(target, snapshot);
+    }
+  }
+
+  fetchWeather(location, function(err, data) {
+    if (!err && data && isFresh('weather')) {
+      snapshot.weather = data;
+    }
+    checkComplete();
+  });
+
+  fetchAQI(location, function(err, data) {
+    if (!err && data && isFresh('aqi')) {
+      snapshot.aqi = data;
+    }
+    checkComplete();
+  });
+
+  fetchPollen(location, function(data) {
+    if (data && isFresh('pollen')) {
+      snapshot.pollen = data;
+    }
+    checkComplete();
+  });
+
+  fetchDailyForecast(location, function(err, data) {
+    if (!err && data && isFresh('daily')) {
+      snapshot.daily = data;
+    }
+    checkComplete();
+  });
+}
+
+// Watch for location changes so arriving at a saved place switches instantly
+function startLocationWatch() {
+  if (locationWatchId !== null) {
+    navigator.geolocation.clearWatch(locationWatchId);
+    locationWatchId = null;
+  }
+  if (getSavedPlaces().length === 0) {
+    return;
+  }
+
+  locationWatchId = navigator.geolocation.watchPosition(
+    function(pos) {
+      var location = {
+        lat: pos.coords.latitude,
+        lon: pos.coords.longitude,
+        time: Math.floor(Date.now() / 1000)
+      };
+      lastLocation = location;
+
+      var place = findSavedPlace(location);
+      var name = place ? place.name : null;
+      if (name === currentPlace) {
+        return;
+      }
+
+      log(LOG.INFO, 'Saved place changed: ' + (currentPlace || 'none') + ' -> ' + (name || 'none'));
+      if (place) {
+        sendPlaceSnapshot(place);
+        currentPlace = name;
+      } else {
+        // Left a saved place - its snapshot no longer applies, fetch for here
+        // (the watch asks again once the wearer is awake)
+        currentPlace = null;
+        if (watchPowerProfile !== POWER_PROFILE.SLEEP) {
+          updateWeather();
+        }
+      }
+    },
+    function(err) {
+      log(LOG.WARN, 'Location watch error: ' + err.message);
+    },
+    {
+      enableHighAccuracy: false,
+      timeout: 60000,
+      maximumAge: 5 * 60000
+    }
+  );
+}
+
+// Send a message directly when it fits the watch's inbox, otherwise as a chunked
+// transfer. success/failure are called once for the whole message. Direct
+// messages go out alongside a pending transfer; a new transfer replaces it.
+function sendToWatch(message, success, failure) {
+  var bytes;
+  try {
+    bytes = transfer.serialize(message, messageKeys);
+  } catch (err) {
+    log(LOG.WARN, 'Cannot serialize message, sending directly: ' + err.message);
+    bytes = [];
+  }
+
+  if (bytes.length <= watchInboxSize) {
+    Pebble.sendAppMessage(message, success, failure);
+    return;
+  }
+  if (bytes.length > watchTransferCapacity) {
+    log(LOG.WARN, 'Message of ' + bytes.length + ' bytes exceeds the watch\'s ' + watchTransferCapacity +
+                  '-byte transfer buffer');
+    if (failure) {
+      failure({ size: bytes.length });
+    }
+    return;
+  }
+
+  abandonTransfer('replaced');  // Anything still pending carries older data
+  var chunkSize = transfer.chunkSize(watchInboxSize);
+  pendingTransfer = {
+    id: Date.now() % 0x7fffffff,
+    bytes: bytes,
+    chunkSize: chunkSize,
+    count: Math.ceil(bytes.length / chunkSize),
+    acked: 0,      // Chunks the watch has confirmed
+    retries: 0,
+    timer: null,
+    started: Date.now(),
+    success: success,
+    failure: failure
+  };
+  log(LOG.INFO, 'Sending ' + bytes.length + ' bytes as transfer ' + pendingTransfer.id +
+                ' (' + pendingTransfer.count + ' chunks)');
+  sendTransferChunk(pendingTransfer);
+}
+
+// Send the first chunk the watch has not confirmed and wait for its ack
+function sendTransferChunk(pending) {
+  var index = pending.acked;
+  var chunk = {
+    TRANSFER_ID: pending.id,
+    TRANSFER_CHUNK: index,
+    TRANSFER_COUNT: pending.count,
+    TRANSFER_DATA: pending.bytes.slice(index * pending.chunkSize, (index + 1) * pending.chunkSize)
+  };
+  if (index === 0) {
+    chunk.TRANSFER_SIZE = pending.bytes.length;
+  }
+
+  clearTimeout(pending.timer);
+  pending.timer = setTimeout(function() {
+    transferTimedOut(pending);
+  }, TRANSFER_ACK_TIMEOUT);
+  Pebble.sendAppMessage(chunk, null, function(e) {
+    log(LOG.DEBUG, 'Transfer chunk ' + index + ' not delivered: ' + JSON.stringify(e));  // Retried on timeout
+  });
+}
+
+function transferTimedOut(pending) {
+  if (pending !== pendingTransfer) {
+    return;
+  }
+  pending.timer = null;
+  pending.retries++;
+  if (pending.retries > TRANSFER_MAX_RETRIES) {
+    // Keep it for the watch to resume once it is reachable again
+    log(LOG.WARN, 'Transfer ' + pending.id + ' stalled at chunk ' + pending.acked + '/' + pending.count);
+    if (pending.failure) {
+      pending.failure({ transfer: pending.id });
+      pending.failure = null;
+    }
+    return;
+  }
+  sendTransferChunk(pending);
+}
+
+// Handle a TRANSFER_ACK. Acks sent with a request resume a stalled transfer;
+// other acks confirm the chunk in flight. Returns false when there is nothing
+// to continue (unknown or expired transfer).
+function handleTransferAck(id, acked, resume) {
+  var pending = pendingTransfer;
+  if (!pending || pending.id !== id) {
+    return false;
+  }
+
+  if (acked === TRANSFER_REJECTED) {
+    clearTransfer();
+    log(LOG.WARN, 'Transfer ' + pending.id + ' rejected by the watch');
+    if (pending.failure) {
+      pending.failure({ transfer: pending.id, rejected: true });
+    }
+    return true;
+  }
+  if (acked >= pending.count) {
+    clearTransfer();
+    log(LOG.INFO, 'Transfer ' + pending.id + ' complete');
+    if (pending.success) {
+      pending.success({ transfer: pending.id });
+    }
+    return true;
+  }
+  if (Date.now() - pending.started > TRANSFER_RESUME_AGE) {
+    abandonTransfer('expired');
+    return false;
+  }
+  if (!resume && acked <= pending.acked) {
+    return true;  // Duplicate ack of a resent chunk - the chunk in flight is still covered by its timeout
+  }
+
+  if (resume) {
+    log(LOG.INFO, 'Resuming transfer ' + pending.id + ' at chunk ' + acked + '/' + pending.count);
+  }
+  if (acked > pending.acked) {
+    pending.retries = 0;
+  }
+  pending.acked = acked;
+  sendTransferChunk(pending);
+  return true;
+}
+
+function clearTransfer() {
+  if (pendingTransfer) {
+    clearTimeout(pendingTransfer.timer);
+    pendingTransfer = null;
+  }
+}
+
+// Drop an unfinished transfer; its sync is reported as failed unless a stall already did
+function abandonTransfer(reason) {
+  var pending = pendingTransfer;
+  if (!pending) {
+    return;
+  }
+  clearTransfer();
+  log(LOG.WARN, 'Transfer ' + pending.id + ' ' + reason + ' at chunk ' + pending.acked + '/' + pending.count);
+  if (pending.failure) {
+    pending.failure({ transfer: pending.id, abandoned: reason });
+  }
+}
+
+function setBenchmarkEndpoint(endpoint) {
+  if (endpoint === benchmarkEndpoint) {
+    return;
+  }
+  benchmarkEndpoint = endpoint;
+  if (endpoint) {
+    log(LOG.INFO, 'Benchmark build: providers served by ' + endpoint);
+    localStorage.setItem('fitzface_benchmark_endpoint', endpoint);
   } else {
-    message.POLLEN_TREE = -1;  // -1 indicates no data
-    message.POLLEN_GRASS = -1;
-    message.POLLEN_WEED = -1;
+    localStorage.removeItem('fitzface_benchmark_endpoint');
   }
+}
 
-    // Send to watch
-    console.log('Sending message to watch:', JSON.stringify(message));
-    Pebble.sendAppMessage(message,
-      function(e) {
-        console.log('Message sent successfully');
-      },
-      function(e) {
-        console.log('Error sending message: ' + JSON.stringify(e));
+// Merge the benchmark scenario's settings for this point of the timeline (e.g. the
+// theme) into CONFIG, as if they had come from the settings page
+function applyBenchmarkConfig(callback) {
+  var xhr = new XMLHttpRequest();
+  xhr.open('GET', benchmarkEndpoint + '/benchmark/config', true);
+  xhr.timeout = 5000;
+  xhr.onload = function() {
+    if (xhr.readyState === 4) {
+      if (xhr.status === 200) {
+        try {
+          CONFIG = Object.assign(CONFIG, JSON.parse(xhr.responseText));
+        } catch (e) {
+          log(LOG.WARN, 'Error parsing benchmark config: ' + e);
+        }
       }
-    );
+      callback();
+    }
+  };
+  xhr.onerror = callback;
+  xhr.ontimeout = callback;
+  xhr.send();
+}
+
+// Ask the watch for its event log (answered with EVENT_LOG)
+function requestWatchEventLog() {
+  Pebble.sendAppMessage({ EVENT_LOG_REQUEST: 1 }, null, function(e) {
+    log(LOG.WARN, 'Error requesting watch event log: ' + JSON.stringify(e));
   });
 }
 
+// Print the watch's EVENT_LOG byte array: event count, then per event a uint32
+// time, type and int16 value (little endian), oldest first
+function logWatchEventLog(bytes) {
+  var count = bytes[0];
+  log(LOG.INFO, 'Watch event log (' + count + ' events):');
+  for (var i = 0; i < count; i++) {
+    var at = 1 + i * EVENT_LOG_ENTRY_SIZE;
+    var time = (bytes[at] | (bytes[at + 1] << 8) | (bytes[at + 2] << 16) | (bytes[at + 3] << 24)) >>> 0;
+    var value = (bytes[at + 5] | (bytes[at + 6] << 8)) << 16 >> 16;
+    log(LOG.INFO, '  ' + new Date(time * 1000).toISOString() + ' ' +
+                  (EVENT_NAMES[bytes[at + 4]] || 'event ' + bytes[at + 4]) + ' ' + value);
+  }
+}
+
 // Pebble event handlers
 Pebble.addEventListener('ready', function(e) {
-  console.log('PebbleKit JS ready!');
+  log(LOG.INFO, 'PebbleKit JS ready!');
   loadConfig();
+  loadProviderHealth();
+  loadWatchState();
+  migrateCacheUnits();
   updateWeather();
+  startLocationWatch();
 });
 
 Pebble.addEventListener('appmessage', function(e) {
-  console.log('AppMessage received from watch');
-  // Watch is requesting update
-  updateWeather();
+  log(LOG.DEBUG, 'AppMessage received from watch');
+  if (e.payload.EVENT_LOG !== undefined) {
+    logWatchEventLog(e.payload.EVENT_LOG);
+    return;
+  }
+  if (e.payload.INBOX_SIZE !== undefined) {
+    watchInboxSize = e.payload.INBOX_SIZE;
+    localStorage.setItem('fitzface_inbox_size', String(watchInboxSize));
+  }
+  if (e.payload.TRANSFER_CAPACITY !== undefined) {
+    watchTransferCapacity = e.payload.TRANSFER_CAPACITY;
+    localStorage.setItem('fitzface_transfer_capacity', String(watchTransferCapacity));
+  }
+  if (e.payload.WATCH_FEATURES !== undefined) {
+    watchFeatures = e.payload.WATCH_FEATURES;
+    localStorage.setItem('fitzface_watch_features', String(watchFeatures));
+  }
+  if (e.payload.POWER_PROFILE !== undefined) {
+    watchPowerProfile = e.payload.POWER_PROFILE;
+    localStorage.setItem('fitzface_power_profile', String(watchPowerProfile));
+  }
+  if (e.payload.TRANSFER_ACK !== undefined) {
+    var requesting = e.payload.REFRESH_SOURCES !== undefined;
+    if (handleTransferAck(e.payload.TRANSFER_ID, e.payload.TRANSFER_ACK, requesting) || !requesting) {
+      return;  // Chunk ack, or a request answered by resuming the transfer (its data is newer)
+    }
+  }
+  if (e.payload.REFRESH_SOURCES !== undefined) {
+    setBenchmarkEndpoint(e.payload.BENCHMARK_ENDPOINT || null);
+  }
+  if (benchmarkEndpoint) {
+    applyBenchmarkConfig(function() {
+      updateWeather(e.payload.REFRESH_SOURCES);
+    });
+    return;
+  }
+  // Watch is requesting update of the groups past their refresh budget
+  updateWeather(e.payload.REFRESH_SOURCES);
 });
 
 Pebble.addEventListener('showConfiguration', function(e) {
-  console.log('Showing configuration');
+  log(LOG.DEBUG, 'Showing configuration');
   // Clay will handle this
 });
 
 Pebble.addEventListener('webviewclosed', function(e) {
-  console.log('Configuration window closed');
+  log(LOG.DEBUG, 'Configuration window closed');
 
   if (e && !e.response) {
-    console.log('No configuration data returned');
+    log(LOG.DEBUG, 'No configuration data returned');
     return;
   }
 
   // Get the config data from Clay
   var configData = JSON.parse(decodeURIComponent(e.response));
-  console.log('Configuration received');
+  log(LOG.INFO, 'Configuration received');
+  var fetchSettings = fetchConfigKey();
 
   // Update CONFIG object (Clay sends values wrapped in {value: X})
-  if (configData.TIDE_STATION) {
-    CONFIG.TIDE_STATION = configData.TIDE_STATION.value;
+  if (configData.TIDE_STATION !== undefined) {
+    CONFIG.TIDE_STATION = configData.TIDE_STATION.value.trim();  // Empty = nearest station
   }
   if (configData.CONFIG_TEMP_UNIT) {
-    console.log('Temperature unit changed from', CONFIG.TEMP_UNIT, 'to', configData.CONFIG_TEMP_UNIT.value);
+    log(LOG.DEBUG, 'Temperature unit changed from ' + CONFIG.TEMP_UNIT + ' to ' + configData.CONFIG_TEMP_UNIT.value);
     CONFIG.TEMP_UNIT = configData.CONFIG_TEMP_UNIT.value;
   }
+  if (configData.CONFIG_WIND_UNIT) {
+    CONFIG.WIND_UNIT = configData.CONFIG_WIND_UNIT.value;
+  }
   if (configData.SHOW_AQI !== undefined) {
     CONFIG.SHOW_AQI = configData.SHOW_AQI.value;
   }
@@ -1009,6 +2769,12 @@ Pebble.addEventListener('webviewclosed', function(e) {
   if (configData.MUNI_DIRECTION) {
     CONFIG.MUNI_DIRECTION = configData.MUNI_DIRECTION.value;
   }
+  if (configData.MUNI_EXTRA_ROUTES !== undefined) {
+    CONFIG.MUNI_EXTRA_ROUTES = configData.MUNI_EXTRA_ROUTES.value.trim();
+  }
+  if (configData.MUNI_SCHEDULE_URL !== undefined) {
+    CONFIG.MUNI_SCHEDULE_URL = configData.MUNI_SCHEDULE_URL.value.trim();
+  }
 
   // Pollen configuration
   if (configData.POLLEN_ENABLED !== undefined) {
@@ -1018,9 +2784,35 @@ Pebble.addEventListener('webviewclosed', function(e) {
     CONFIG.POLLEN_API_KEY = configData.POLLEN_API_KEY.value.trim();
   }
 
+  // Saved places
+  if (configData.SAVED_PLACES !== undefined) {
+    CONFIG.SAVED_PLACES = configData.SAVED_PLACES.value.trim();
+  }
+
+  // Quiet hours
+  if (configData.QUIET_START !== undefined) {
+    CONFIG.QUIET_START = parseInt(configData.QUIET_START.value, 10);
+  }
+  if (configData.QUIET_END !== undefined) {
+    CONFIG.QUIET_END = parseInt(configData.QUIET_END.value, 10);
+  }
+
+  // Diagnostics: raising the log level also dumps the watch's event log
+  if (configData.LOG_LEVEL !== undefined) {
+    CONFIG.LOG_LEVEL = parseInt(configData.LOG_LEVEL.value, 10);
+    if (logEnabled(LOG.INFO)) {
+      requestWatchEventLog();
+    }
+  }
+
   // Save config
   saveConfig();
+  startLocationWatch();
 
-  // Update weather with new config
+  // Display-only changes (units, theme, shown fields) apply without a fetch
+  if (fetchConfigKey() === fetchSettings) {
+    sendConfigToWatch();
+    return;
+  }
   updateWeather();
 });
@@ -0,0 +1,154 @@
+// FitzFace - Open-Meteo FlatBuffers decoding
+// With format=flatbuffers Open-Meteo answers with one size-prefixed
+// WeatherApiResponse per location (weather_api.fbs in openmeteo-sdk) instead of
+// JSON. Only the sections and fields FitzFace reads are decoded, straight from
+// the buffer, into the same shape JSON.parse would return.
+//
+// Variables come back in the order they were requested, so a section is decoded
+// against the same name list that built the query string.
+
+// Field slots (declaration order in weather_api.fbs)
+var RESPONSE_UTC_OFFSET = 6;
+var RESPONSE_SECTIONS = { current: 9, daily: 10, hourly: 11, minutely_15: 12 };
+var SECTION_TIME = 0;
+var SECTION_TIME_END = 1;
+var SECTION_INTERVAL = 2;
+var SECTION_VARIABLES = 3;
+var VARIABLE_VALUE = 2;
+var VARIABLE_VALUES = 3;
+
+// Query string for a { section: [variable names] } request
+function query(variables) {
+  var parts = [];
+  for (var section in variables) {
+    parts.push('&' + section + '=' + variables[section].join(','));
+  }
+  return parts.join('');
+}
+
+function Reader(buffer) {
+  this.view = new DataView(buffer);
+}
+
+Reader.prototype.uint16 = function(pos) {
+  return this.view.getUint16(pos, true);
+};
+
+Reader.prototype.int32 = function(pos) {
+  return this.view.getInt32(pos, true);
+};
+
+Reader.prototype.int64 = function(pos) {
+  return this.view.getUint32(pos, true) + this.view.getInt32(pos + 4, true) * 4294967296;
+};
+
+// Position of a table field, or 0 when the field is absent (default value)
+Reader.prototype.field = function(table, slot) {
+  var vtable = table - this.int32(table);
+  var entry = 4 + slot * 2;
+  var offset = entry < this.uint16(vtable) ? this.uint16(vtable + entry) : 0;
+  return offset ? table + offset : 0;
+};
+
+// Follow the offset stored at a table/vector/string reference
+Reader.prototype.deref = function(pos) {
+  return pos + this.view.getUint32(pos, true);
+};
+
+// Float vector as an array, NaN (no data) as null like the JSON format
+Reader.prototype.floats = function(pos) {
+  var vector = this.deref(pos);
+  var length = this.view.getUint32(vector, true);
+  var values = [];
+  for (var i = 0; i < length; i++) {
+    var value = this.view.getFloat32(vector + 4 + i * 4, true);
+    values.push(isNaN(value) ? null : value);
+  }
+  return values;
+};
+
+function pad(n) {
+  return n < 10 ? '0' + n : '' + n;
+}
+
+// Local ISO time like the JSON format with timezone=auto ("2024-05-01T14:00")
+function localTime(unix, utcOffset) {
+  var date = new Date((unix + utcOffset) * 1000);
+  return date.getUTCFullYear() + '-' + pad(date.getUTCMonth() + 1) + '-' + pad(date.getUTCDate()) +
+    'T' + pad(date.getUTCHours()) + ':' + pad(date.getUTCMinutes());
+}
+
+function decodeSection(reader, section, name, names, utcOffset) {
+  var result = {};
+  var variables = reader.field(section, SECTION_VARIABLES);
+  var vector = variables ? reader.deref(variables) : 0;
+  var count = vector ? reader.view.getUint32(vector, true) : 0;
+  if (count < names.length) {
+    throw new Error(name + ' has ' + count + ' variables, expected ' + names.length);
+  }
+
+  // Current conditions carry one value; hourly, daily and minutely_15 carry a series over time..time_end
+  if (name !== 'current') {
+    var timeField = reader.field(section, SECTION_TIME);
+    var endField = reader.field(section, SECTION_TIME_END);
+    var intervalField = reader.field(section, SECTION_INTERVAL);
+    var start = timeField ? reader.int64(timeField) : 0;
+    var end = endField ? reader.int64(endField) : 0;
+    var interval = intervalField ? reader.int32(intervalField) : 0;
+    if (interval <= 0) {
+      throw new Error(name + ' has no interval');
+    }
+    result.time = [];
+    for (var t = start; t < end; t += interval) {
+      var time = localTime(t, utcOffset);
+      result.time.push(name === 'daily' ? time.slice(0, 10) : time);
+    }
+  }
+
+  for (var i = 0; i < names.length; i++) {
+    var variable = reader.deref(vector + 4 + i * 4);
+    if (name === 'current') {
+      var valueField = reader.field(variable, VARIABLE_VALUE);
+      var value = valueField ? reader.view.getFloat32(valueField, true) : 0;
+      result[names[i]] = isNaN(value) ? null : value;
+    } else {
+      var valuesField = reader.field(variable, VARIABLE_VALUES);
+      result[names[i]] = valuesField ? reader.floats(valuesField) : [];
+    }
+  }
+  return result;
+}
+
+// Decode the first location of a FlatBuffers response into the JSON shape for
+// the requested { section: [variable names] }. Throws on anything unexpected so
+// callers can fall back to JSON.
+function decode(buffer, variables) {
+  if (typeof ArrayBuffer === 'undefined' || !(buffer instanceof ArrayBuffer) || buffer.byteLength < 8) {
+    throw new Error('Not a binary response');
+  }
+
+  var reader = new Reader(buffer);
+  var size = reader.view.getUint32(0, true);
+  if (size + 4 > buffer.byteLength) {
+    throw new Error('Truncated response');
+  }
+  var root = reader.deref(4);
+
+  var offsetField = reader.field(root, RESPONSE_UTC_OFFSET);
+  var utcOffset = offsetField ? reader.int32(offsetField) : 0;
+  var response = { utc_offset_seconds: utcOffset };
+
+  for (var name in variables) {
+    var slot = reader.field(root, RESPONSE_SECTIONS[name]);
+    if (!slot) {
+      throw new Error('Response has no ' + name + ' section');
+    }
+    response[name] = decodeSection(reader, reader.deref(slot), name, variables[name], utcOffset);
+  }
+  return response;
+}
+
+module.exports = {
+  query: query,
+  decode: decode
+};
@@ -0,0 +1,80 @@
+// FitzFace - MUNI schedule fallback
+// Scheduled arrivals computed from a compact index of SFMTA GTFS stop_times for
+// the configured stops (built by tools/muni_schedule.py), used whenever 511's
+// real-time predictions are unavailable.
+//
+// Index layout:
+//   { v: 1,
+//     services: { service_id: { days: "1111100" (Mon..Sun), start: 20260901, end: 20261231,
+//                               add: [20261126], remove: [20261125] } },
+//     stops: { stop_code: { "ROUTE/DIR": { service_id: [minutes] } } } }
+// Minutes count from midnight of the service day (GTFS times can pass 24:00) and
+// are delta encoded: the first value is absolute, each next one adds to it.
+
+var INDEX_VERSION = 1;
+
+function yyyymmdd(date) {
+  return date.getFullYear() * 10000 + (date.getMonth() + 1) * 100 + date.getDate();
+}
+
+// Whether a service runs on a local calendar date
+function serviceRuns(service, date) {
+  var day = yyyymmdd(date);
+  if (service.remove && service.remove.indexOf(day) !== -1) {
+    return false;
+  }
+  if (service.add && service.add.indexOf(day) !== -1) {
+    return true;
+  }
+  var weekday = (date.getDay() + 6) % 7;  // Monday first, like GTFS calendar.txt
+  return day >= service.start && day <= service.end && service.days.charAt(weekday) === '1';
+}
+
+function validIndex(index) {
+  return !!(index && index.v === INDEX_VERSION && index.services && index.stops);
+}
+
+// Next scheduled arrivals of a route at a stop after nowMs: up to max Unix
+// timestamps, ascending. Yesterday's service day is included for trips past midnight.
+function scheduledArrivals(index, stop, route, direction, nowMs, max) {
+  if (!validIndex(index) || !index.stops[stop]) {
+    return [];
+  }
+  var trips = index.stops[stop][route + '/' + direction];
+  if (!trips) {
+    return [];
+  }
+
+  var now = new Date(nowMs);
+  var arrivals = [];
+  for (var offset = -1; offset <= 1; offset++) {
+    var serviceDay = new Date(now.getFullYear(), now.getMonth(), now.getDate() + offset);
+    for (var serviceId in trips) {
+      var service = index.services[serviceId];
+      if (!service || !serviceRuns(service, serviceDay)) {
+        continue;
+      }
+      var minutes = 0;
+      var times = trips[serviceId];
+      for (var i = 0; i < times.length; i++) {
+        minutes += times[i];
+        var arrival = new Date(serviceDay.getFullYear(), serviceDay.getMonth(), serviceDay.getDate(),
+                               0, minutes).getTime();
+        if (arrival > nowMs) {
+          arrivals.push(Math.floor(arrival / 1000));
+        }
+      }
+    }
+    if (arrivals.length >= max) {
+      break;  // Later service days only add later arrivals
+    }
+  }
+
+  arrivals.sort(function(a, b) { return a - b; });
+  return arrivals.slice(0, max);
+}
+
+module.exports = {
+  validIndex: validIndex,
+  scheduledArrivals: scheduledArrivals
+};
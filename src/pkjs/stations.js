@@ -0,0 +1,103 @@
+// FitzFace - Nearest tide station lookup
+// NOAA's harmonic tide stations bucketed into a lat/lon grid, so the station
+// nearest to the wearer is found from a handful of cells with no network lookup.
+// The index is built once from NOAA's station list and cached by the companion.
+//
+// Index layout (compact for localStorage):
+//   { cellDegrees: 0.5, count: N, cells: { "row,col": [[id, lat, lon], ...] } }
+// with coordinates rounded to 1e-3 degrees (~100 m).
+
+var CELL_DEGREES = 0.5;
+var MAX_RINGS = 20;                // Give up beyond ~10 degrees (no coast nearby)
+var KM_PER_DEGREE = 111.32;
+
+function cellRow(lat, cellDegrees) {
+  return Math.floor((lat + 90) / cellDegrees);
+}
+
+function cellCol(lon, cellDegrees) {
+  return Math.floor((((lon + 180) % 360 + 360) % 360) / cellDegrees);
+}
+
+// Grid cell of a position ("row,col"), also used to notice cell changes
+function cellOf(index, lat, lon) {
+  return cellRow(lat, index.cellDegrees) + ',' + cellCol(lon, index.cellDegrees);
+}
+
+// Build the index from NOAA mdapi stations.json?type=harcon ({ stations: [{ id, lat, lng }] })
+function buildIndex(response) {
+  var list = (response && response.stations) || [];
+  var index = { cellDegrees: CELL_DEGREES, count: 0, cells: {} };
+  for (var i = 0; i < list.length; i++) {
+    var lat = parseFloat(list[i].lat);
+    var lon = parseFloat(list[i].lng);
+    if (!list[i].id || isNaN(lat) || isNaN(lon)) {
+      continue;
+    }
+    var key = cellOf(index, lat, lon);
+    if (!index.cells[key]) {
+      index.cells[key] = [];
+    }
+    index.cells[key].push([String(list[i].id), Math.round(lat * 1000) / 1000, Math.round(lon * 1000) / 1000]);
+    index.count++;
+  }
+  if (index.count === 0) {
+    throw new Error('Station list is empty');
+  }
+  return index;
+}
+
+// Equirectangular distance in km (accurate enough to rank nearby stations)
+function distanceKm(lat1, lon1, lat2, lon2) {
+  var dLon = Math.abs(lon2 - lon1);
+  if (dLon > 180) {
+    dLon = 360 - dLon;
+  }
+  var x = dLon * Math.cos((lat1 + lat2) / 2 * Math.PI / 180);
+  var y = lat2 - lat1;
+  return Math.sqrt(x * x + y * y) * KM_PER_DEGREE;
+}
+
+// Nearest station to a position: { id, km } or null when none is within MAX_RINGS.
+// Cells are searched in rings around the position's cell until the next ring
+// can't hold anything closer than the best match so far.
+function nearest(index, lat, lon) {
+  var size = index.cellDegrees;
+  var row = cellRow(lat, size);
+  var col = cellCol(lon, size);
+  var cols = Math.round(360 / size);
+  var best = null;
+
+  for (var ring = 0; ring <= MAX_RINGS; ring++) {
+    // Stations in this ring are at least ring - 1 cells away; longitude is
+    // scaled at the ring's poleward edge so the bound never overestimates
+    if (best && (ring - 1) * size * KM_PER_DEGREE * Math.cos(Math.min(Math.abs(lat) + ring * size, 89) *
+                                                             Math.PI / 180) > best.km) {
+      break;
+    }
+    for (var dr = -ring; dr <= ring; dr++) {
+      for (var dc = -ring; dc <= ring; dc++) {
+        if (Math.abs(dr) !== ring && Math.abs(dc) !== ring) {
+          continue;  // Inner cells were searched by earlier rings
+        }
+        var cell = index.cells[(row + dr) + ',' + (((col + dc) % cols) + cols) % cols];
+        if (!cell) {
+          continue;
+        }
+        for (var i = 0; i < cell.length; i++) {
+          var km = distanceKm(lat, lon, cell[i][1], cell[i][2]);
+          if (!best || km < best.km) {
+            best = { id: cell[i][0], km: km };
+          }
+        }
+      }
+    }
+  }
+  return best;
+}
+
+module.exports = {
+  buildIndex: buildIndex,
+  cellOf: cellOf,
+  nearest: nearest
+};
@@ -0,0 +1,261 @@
+// FitzFace - Harmonic tide prediction
+// Computes tide heights and high/low times locally from a station's NOAA
+// harmonic constituents, so tides need no network once the constants are cached.
+//
+// h(t) = Z0 + sum( f * A * cos(V0 + u + speed * (t - t0) - G) )
+//
+// A, G (phase_GMT) and speed come from NOAA's harcon.json. V0 (equilibrium
+// argument at t0), f (node factor) and u (node correction) follow Schureman,
+// "Manual of Harmonic Analysis and Prediction of Tides" (1958).
+
+var DEG = Math.PI / 180;
+
+// Equilibrium arguments as coefficients of [T, s, h, p, p1, constant] where
+// T = hour angle of the mean sun, s = moon, h = sun, p = lunar perigee,
+// p1 = solar perigee (all mean longitudes, degrees). 'node' names the
+// f/u formula applied; shallow-water constituents combine their parents.
+var CONSTITUENTS = {
+  M2:   { v: [2, -2, 2, 0, 0, 0],    node: 'M2' },
+  S2:   { v: [2, 0, 0, 0, 0, 0],     node: null },
+  N2:   { v: [2, -3, 2, 1, 0, 0],    node: 'M2' },
+  K2:   { v: [2, 0, 2, 0, 0, 0],     node: 'K2' },
+  L2:   { v: [2, -1, 2, -1, 0, 180], node: 'M2' },
+  '2N2': { v: [2, -4, 2, 2, 0, 0],   node: 'M2' },
+  MU2:  { v: [2, -4, 4, 0, 0, 0],    node: 'M2' },
+  NU2:  { v: [2, -3, 4, -1, 0, 0],   node: 'M2' },
+  LAM2: { v: [2, -1, 0, 1, 0, 180],  node: 'M2' },
+  T2:   { v: [2, 0, -1, 0, 1, 0],    node: null },
+  R2:   { v: [2, 0, 1, 0, -1, 180],  node: null },
+  '2SM2': { v: [2, 2, -2, 0, 0, 0],  node: '-M2' },
+  K1:   { v: [1, 0, 1, 0, 0, -90],   node: 'K1' },
+  O1:   { v: [1, -2, 1, 0, 0, 90],   node: 'O1' },
+  P1:   { v: [1, 0, -1, 0, 0, 90],   node: null },
+  Q1:   { v: [1, -3, 1, 1, 0, 90],   node: 'O1' },
+  '2Q1': { v: [1, -4, 1, 2, 0, 90],  node: 'O1' },
+  RHO:  { v: [1, -3, 3, -1, 0, 90],  node: 'O1' },
+  J1:   { v: [1, 1, 1, -1, 0, -90],  node: 'J1' },
+  OO1:  { v: [1, 2, 1, 0, 0, -90],   node: 'OO1' },
+  S1:   { v: [1, 0, 0, 0, 0, 0],     node: null },
+  MM:   { v: [0, 1, 0, -1, 0, 0],    node: 'MM' },
+  MF:   { v: [0, 2, 0, 0, 0, 0],     node: 'MF' },
+  MSF:  { v: [0, 2, -2, 0, 0, 0],    node: '-M2' },
+  SA:   { v: [0, 0, 1, 0, 0, 0],     node: null },
+  SSA:  { v: [0, 0, 2, 0, 0, 0],     node: null },
+  M4:   { parts: { M2: 2 } },
+  M6:   { parts: { M2: 3 } },
+  M8:   { parts: { M2: 4 } },
+  MN4:  { parts: { M2: 1, N2: 1 } },
+  MS4:  { parts: { M2: 1, S2: 1 } },
+  S4:   { parts: { S2: 2 } },
+  S6:   { parts: { S2: 3 } },
+  MK3:  { parts: { M2: 1, K1: 1 } },
+  '2MK3': { parts: { M2: 2, K1: -1 } }
+};
+
+function normalize(deg) {
+  deg = deg % 360;
+  return deg < 0 ? deg + 360 : deg;
+}
+
+// Mean astronomical longitudes (degrees) at a Unix time in milliseconds
+function astronomicalArguments(ms) {
+  var T = (ms / 86400000 + 2440587.5 - 2451545.0) / 36525;  // Julian centuries from J2000
+  var utHours = (ms % 86400000) / 3600000;
+  return {
+    T: normalize(180 + 15 * utHours),
+    s: normalize(218.3164477 + 481267.88123421 * T),
+    h: normalize(280.4664567 + 36000.76983 * T),
+    p: normalize(83.3532465 + 4069.0137287 * T),
+    N: normalize(125.04452 - 1934.136261 * T),
+    p1: normalize(282.94 + 1.7192 * T)
+  };
+}
+
+// Node factors (f) and corrections (u, degrees) for the base formulas
+function nodeTerms(N) {
+  var n = N * DEG;
+  var I = Math.acos(0.91370 - 0.03569 * Math.cos(n));
+  var nu = Math.asin(0.08968 * Math.sin(n) / Math.sin(I));
+  var xi = n - 2 * Math.atan(0.64412 * Math.tan(n / 2)) - nu;
+  var nuP = Math.atan2(Math.sin(2 * I) * Math.sin(nu), Math.sin(2 * I) * Math.cos(nu) + 0.3347);
+  var nu2P = Math.atan2(Math.pow(Math.sin(I), 2) * Math.sin(2 * nu),
+                        Math.pow(Math.sin(I), 2) * Math.cos(2 * nu) + 0.0727) / 2;
+  var sinI = Math.sin(I);
+  var sin2I = Math.sin(2 * I);
+
+  var fM2 = Math.pow(Math.cos(I / 2), 4) / 0.9154;
+  var uM2 = (2 * xi - 2 * nu) / DEG;
+  return {
+    M2: { f: fM2, u: uM2 },
+    '-M2': { f: fM2, u: -uM2 },
+    K2: { f: Math.sqrt(19.0444 * Math.pow(sinI, 4) + 2.7702 * sinI * sinI * Math.cos(2 * nu) + 0.0981),
+          u: -2 * nu2P / DEG },
+    K1: { f: Math.sqrt(0.8965 * sin2I * sin2I + 0.6001 * sin2I * Math.cos(nu) + 0.1006),
+          u: -nuP / DEG },
+    O1: { f: sinI * Math.pow(Math.cos(I / 2), 2) / 0.3800, u: (2 * xi - nu) / DEG },
+    J1: { f: sin2I / 0.7214, u: -nu / DEG },
+    OO1: { f: sinI * Math.pow(Math.sin(I / 2), 2) / 0.01640, u: (-2 * xi - nu) / DEG },
+    MM: { f: (2 / 3 - sinI * sinI) / 0.5021, u: 0 },
+    MF: { f: sinI * sinI / 0.1578, u: -2 * xi / DEG }
+  };
+}
+
+// Equilibrium argument V0 + u (degrees) and node factor f of a constituent
+function constituentArguments(name, astro, nodes) {
+  var def = CONSTITUENTS[name];
+  if (!def) {
+    return null;
+  }
+
+  if (def.parts) {
+    var result = { vu: 0, f: 1 };
+    for (var part in def.parts) {
+      var base = constituentArguments(part, astro, nodes);
+      var count = def.parts[part];
+      result.vu += count * base.vu;
+      result.f *= Math.pow(base.f, Math.abs(count));
+    }
+    result.vu = normalize(result.vu);
+    return result;
+  }
+
+  var v = def.v;
+  var V0 = v[0] * astro.T + v[1] * astro.s + v[2] * astro.h + v[3] * astro.p + v[4] * astro.p1 + v[5];
+  var node = def.node ? nodes[def.node] : { f: 1, u: 0 };
+  return { vu: normalize(V0 + node.u), f: node.f };
+}
+
+// Build a cacheable model from NOAA harcon.json and datums.json responses.
+// Heights are relative to MLLW to match NOAA's tide predictions.
+function buildModel(station, harcon, datums) {
+  var msl = null;
+  var mllw = null;
+  for (var i = 0; i < datums.datums.length; i++) {
+    if (datums.datums[i].name === 'MSL') msl = datums.datums[i].value;
+    if (datums.datums[i].name === 'MLLW') mllw = datums.datums[i].value;
+  }
+  if (msl === null || mllw === null) {
+    throw new Error('Station ' + station + ' has no MSL/MLLW datums');
+  }
+
+  var constituents = [];
+  var list = harcon.HarmonicConstituents || [];
+  for (var j = 0; j < list.length; j++) {
+    var c = list[j];
+    if (c.amplitude > 0 && CONSTITUENTS[c.name]) {
+      constituents.push({ name: c.name, amplitude: c.amplitude, phase: c.phase_GMT, speed: c.speed });
+    }
+  }
+  if (constituents.length === 0) {
+    throw new Error('Station ' + station + ' has no usable harmonic constituents');
+  }
+
+  return {
+    station: station,
+    z0: msl - mllw,
+    constituents: constituents
+  };
+}
+
+// Precompute per-constituent terms for a prediction window starting at t0
+function prepare(model, t0) {
+  var astro = astronomicalArguments(t0);
+  var nodes = nodeTerms(astronomicalArguments(t0 + 12 * 3600000).N);
+  var terms = [];
+  for (var i = 0; i < model.constituents.length; i++) {
+    var c = model.constituents[i];
+    var args = constituentArguments(c.name, astro, nodes);
+    terms.push({
+      amplitude: args.f * c.amplitude,
+      phase: (args.vu - c.phase) * DEG,
+      speed: c.speed * DEG  // Radians per hour
+    });
+  }
+  return terms;
+}
+
+function heightAt(model, terms, hours) {
+  var height = model.z0;
+  for (var i = 0; i < terms.length; i++) {
+    height += terms[i].amplitude * Math.cos(terms[i].phase + terms[i].speed * hours);
+  }
+  return height;
+}
+
+function slopeAt(terms, hours) {
+  var slope = 0;
+  for (var i = 0; i < terms.length; i++) {
+    slope -= terms[i].amplitude * terms[i].speed * Math.sin(terms[i].phase + terms[i].speed * hours);
+  }
+  return slope;
+}
+
+// Predict high/low tides between startMs and startMs + hours.
+// Returns [{ time: Unix seconds, height: feet above MLLW, type: 'H' | 'L' }]
+function predictExtremes(model, startMs, hours) {
+  var STEP = 1 / 6;  // Scan the slope every 10 minutes
+  var terms = prepare(model, startMs);
+  var extremes = [];
+  var prevSlope = slopeAt(terms, 0);
+
+  for (var t = STEP; t <= hours; t += STEP) {
+    var slope = slopeAt(terms, t);
+    if ((prevSlope > 0) !== (slope > 0)) {
+      // Bisect the slope sign change down to ~1 minute
+      var lo = t - STEP;
+      var hi = t;
+      var loSlope = prevSlope;
+      while (hi - lo > 1 / 60) {
+        var mid = (lo + hi) / 2;
+        var midSlope = slopeAt(terms, mid);
+        if ((midSlope > 0) === (loSlope > 0)) {
+          lo = mid;
+          loSlope = midSlope;
+        } else {
+          hi = mid;
+        }
+      }
+      var at = (lo + hi) / 2;
+      extremes.push({
+        time: Math.round((startMs + at * 3600000) / 1000),
+        height: Math.round(heightAt(model, terms, at) * 1000) / 1000,
+        type: prevSlope > 0 ? 'H' : 'L'
+      });
+    }
+    prevSlope = slope;
+  }
+  return extremes;
+}
+
+// Compare local extremes against NOAA hilo predictions.
+// Returns the worst timing (minutes) and height (feet) error over matched pairs.
+function compareWithNOAA(extremes, noaaPredictions, parseTime) {
+  var worstMinutes = 0;
+  var worstHeight = 0;
+  var matched = 0;
+
+  for (var i = 0; i < noaaPredictions.length; i++) {
+    var reference = noaaPredictions[i];
+    var refTime = parseTime(reference.t);
+    var best = null;
+    for (var j = 0; j < extremes.length; j++) {
+      if (extremes[j].type === reference.type &&
+          (!best || Math.abs(extremes[j].time - refTime) < Math.abs(best.time - refTime))) {
+        best = extremes[j];
+      }
+    }
+    if (best && Math.abs(best.time - refTime) < 3 * 3600) {
+      worstMinutes = Math.max(worstMinutes, Math.abs(best.time - refTime) / 60);
+      worstHeight = Math.max(worstHeight, Math.abs(best.height - parseFloat(reference.v)));
+      matched++;
+    }
+  }
+
+  return { matched: matched, minutes: worstMinutes, height: worstHeight };
+}
+
+module.exports = {
+  buildModel: buildModel,
+  predictExtremes: predictExtremes,
+  compareWithNOAA: compareWithNOAA
+};
@@ -0,0 +1,91 @@
+// FitzFace - Chunked transfers
+// A message too large for the watch's inbox is serialized into the Pebble
+// dictionary format the watch would have received, split into chunks and sent
+// as a transfer (receive_transfer_chunk() in fitzface.c). The watch reassembles
+// the bytes and decodes them with dict_read_begin_from_buffer(), so the wire
+// format has to match the firmware's Dictionary layout exactly:
+//
+//   uint8 tuple count, then per tuple:
+//   uint32 key, uint8 type, uint16 length, value (little endian)
+//
+// Types follow PebbleKit JS: numbers and booleans as int32, strings as UTF-8
+// cstrings, byte arrays as-is.
+
+var TUPLE_BYTE_ARRAY = 0;
+var TUPLE_CSTRING = 1;
+var TUPLE_INT = 3;
+
+var DICTIONARY_HEADER_SIZE = 1;
+var TUPLE_HEADER_SIZE = 7;
+
+// Fields of a chunk message besides TRANSFER_DATA: TRANSFER_ID, TRANSFER_CHUNK,
+// TRANSFER_COUNT and TRANSFER_SIZE as int32 tuples
+var CHUNK_OVERHEAD = DICTIONARY_HEADER_SIZE + 5 * TUPLE_HEADER_SIZE + 4 * 4;
+
+function pushUint(bytes, value, size) {
+  for (var i = 0; i < size; i++) {
+    bytes.push((value >>> (i * 8)) & 0xFF);
+  }
+}
+
+function utf8Bytes(text) {
+  var encoded = unescape(encodeURIComponent(text));
+  var bytes = [];
+  for (var i = 0; i < encoded.length; i++) {
+    bytes.push(encoded.charCodeAt(i));
+  }
+  bytes.push(0);
+  return bytes;
+}
+
+// Serialize a { KEY_NAME: value } message using the numeric message keys.
+// Throws on keys or values the watch could not have received directly.
+function serialize(message, keys) {
+  var names = Object.keys(message);
+  if (names.length > 255) {
+    throw new Error('Too many tuples: ' + names.length);
+  }
+
+  var bytes = [names.length];
+  for (var i = 0; i < names.length; i++) {
+    var key = keys[names[i]];
+    var value = message[names[i]];
+    if (key === undefined) {
+      throw new Error('Unknown message key ' + names[i]);
+    }
+
+    var type;
+    var data;
+    if (typeof value === 'number' || typeof value === 'boolean') {
+      type = TUPLE_INT;
+      data = [];
+      pushUint(data, Number(value) | 0, 4);
+    } else if (typeof value === 'string') {
+      type = TUPLE_CSTRING;
+      data = utf8Bytes(value);
+    } else if (value && value.length !== undefined) {
+      type = TUPLE_BYTE_ARRAY;
+      data = Array.prototype.slice.call(value);
+    } else {
+      throw new Error('Unsupported value for ' + names[i]);
+    }
+
+    pushUint(bytes, key, 4);
+    bytes.push(type);
+    pushUint(bytes, data.length, 2);
+    for (var j = 0; j < data.length; j++) {
+      bytes.push(data[j] & 0xFF);
+    }
+  }
+  return bytes;
+}
+
+// Largest TRANSFER_DATA payload that fits an inbox of the given size
+function chunkSize(inboxSize) {
+  return inboxSize - CHUNK_OVERHEAD;
+}
+
+module.exports = {
+  serialize: serialize,
+  chunkSize: chunkSize
+};
@@ -0,0 +1,537 @@
+#!/usr/bin/env python3
+"""Run FitzFace through a simulated day in the emulator and report per-hour costs.
+
+Builds the watchface with FITZFACE_BENCHMARK pointing at a local stand-in for
+every provider (Open-Meteo, NOAA, Nominatim, 511, Google Pollen), installs it on
+the Pebble emulator under an accelerated clock and follows a 24-hour script of
+phone disconnects and theme changes. The watch logs one BENCH line per hour
+(AppMessages and bytes in each direction, persist writes, redraws, heap
+high-water mark); the stand-in counts the bytes the companion fetched.
+
+    tools/benchmark/timeline.py --platform diorite -o timeline.json
+    tools/benchmark/timeline.py --baseline timeline.json --tolerance 0.1
+
+With --baseline the run fails (exit 1) when any hour's messages, bytes, persist
+writes, redraws or fetch bytes grow by more than the tolerance, so battery
+regressions show up before they reach a watch. Open-Meteo is served as
+FlatBuffers like the real API; a run in which the companion fell back to JSON
+doesn't compare with one that didn't (exit 2).
+
+Needs the Pebble SDK (pebble tool and emulator) and libfaketime (faketime),
+which runs the emulator and the phone simulator on the accelerated clock.
+"""
+
+import argparse
+import json
+import math
+import os
+import queue
+import re
+import struct
+import subprocess
+import sys
+import threading
+import time
+from datetime import datetime, timedelta, timezone
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlsplit
+
+HOURS = 24
+REPO = os.path.abspath(os.path.join(os.path.dirname(__file__), '..', '..'))
+BENCH_LINE = re.compile(r'BENCH hour=(\d+)((?: \w+=-?\d+)+)')
+
+# Simulated hours (since the start) at which the phone drops out and comes back
+DISCONNECTS = ((3, 5), (13.5, 14))
+
+# Settings the companion applies at each simulated hour: MUNI and pollen use the
+# stand-in with placeholder keys, and the theme flips for the evening
+BASE_CONFIG = {
+    'MUNI_ENABLED': True,
+    'MUNI_API_KEY': 'benchmark',
+    'MUNI_STOP_CODE': '15553',
+    'MUNI_ROUTE': '38R',
+    'MUNI_DIRECTION': 'IB',
+    'POLLEN_ENABLED': True,
+    'POLLEN_API_KEY': 'benchmark',
+}
+INVERTED_HOURS = range(19, 24)
+
+# Metrics compared against a baseline (heap is reported, not gated)
+GATED = ('in', 'in_bytes', 'out', 'out_bytes', 'persist', 'redraws', 'fetch_bytes')
+
+
+class Clock(object):
+    """Simulated time, as faketime runs it: real elapsed time times the rate since the start."""
+
+    def __init__(self, rate):
+        self.rate = rate
+        self.origin = time.time()
+
+    def restart(self):
+        self.origin = time.time()
+
+    def timestamp(self):
+        return self.origin + (time.time() - self.origin) * self.rate
+
+    def now(self):
+        """Local time, like the emulator's clock and Open-Meteo's timezone=auto."""
+        return datetime.fromtimestamp(self.timestamp())
+
+    def utcnow(self):
+        return datetime.fromtimestamp(self.timestamp(), timezone.utc)
+
+    def utc_offset(self):
+        return int(self.now().astimezone().utcoffset().total_seconds())
+
+    def hour_start(self, moment):
+        return moment.replace(minute=0, second=0, microsecond=0)
+
+
+def iso(moment):
+    # Open-Meteo's local ISO 8601 without seconds
+    return moment.strftime('%Y-%m-%dT%H:%M')
+
+
+def forecast(clock, query):
+    """Open-Meteo forecast: current conditions plus hourly or daily series."""
+    now = clock.now()
+    hour = now.replace(minute=0)
+    swing = math.sin((now.hour - 9) / 24.0 * 2 * math.pi)
+    if 'daily' in query:
+        days = int(query.get('forecast_days', ['7'])[0])
+        dates = [(now + timedelta(days=d)).strftime('%Y-%m-%d') for d in range(days)]
+        return {'daily': {
+            'time': dates,
+            'weather_code': [3] * days,
+            'temperature_2m_max': [20 + d for d in range(days)],
+            'temperature_2m_min': [11 + d for d in range(days)],
+            'precipitation_probability_max': [10 * (d % 4) for d in range(days)],
+            'uv_index_max': [5.5] * days,
+        }}
+    hours = int(query.get('forecast_hours', ['24'])[0])
+    times = [hour + timedelta(hours=h) for h in range(hours)]
+    response = {
+        'current': {'time': iso(now), 'temperature_2m': round(15 + 4 * swing, 1), 'wind_speed_10m': 4.2,
+                    'weather_code': 2, 'uv_index': max(0.0, round(6 * swing, 1))},
+        'hourly': {
+            'time': [iso(t) for t in times],
+            'precipitation_probability': [(t.hour * 7) % 60 for t in times],
+            'precipitation': [0.3 if t.hour % 6 == 0 else 0.0 for t in times],
+            'wind_gusts_10m': [6.3] * hours,
+            'weather_code': [61 if t.hour % 6 == 0 else 2 for t in times],
+            'temperature_2m': [round(15 + 4 * math.sin((t.hour - 9) / 24.0 * 2 * math.pi), 1) for t in times],
+            'uv_index': [max(0.0, round(6 * math.sin((t.hour - 6) / 24.0 * 2 * math.pi), 1)) for t in times],
+        },
+    }
+    if 'minutely_15' in query:
+        # Same showers as the hourly series, so the nowcast counts down to each one
+        slots = int(query.get('forecast_minutely_15', ['12'])[0])
+        quarter = now.replace(minute=now.minute - now.minute % 15)
+        moments = [quarter + timedelta(minutes=15 * q) for q in range(slots)]
+        response['minutely_15'] = {
+            'time': [iso(t) for t in moments],
+            'precipitation': [0.8 if t.hour % 6 == 0 else 0.0 for t in moments],
+        }
+    return response
+
+
+# Open-Meteo FlatBuffers (format=flatbuffers): a size-prefixed WeatherApiResponse
+# (weather_api.fbs in openmeteo-sdk) carrying the same values as the JSON body,
+# with variables in request order like the real API. Field slots as read by
+# src/pkjs/openmeteo.js.
+RESPONSE_UTC_OFFSET = 6
+RESPONSE_TIMEZONE = 7
+RESPONSE_SECTIONS = {'current': 9, 'daily': 10, 'hourly': 11, 'minutely_15': 12}
+SECTION_TIME, SECTION_TIME_END, SECTION_INTERVAL, SECTION_VARIABLES = 0, 1, 2, 3
+VARIABLE_VALUE, VARIABLE_VALUES = 2, 3
+SECTION_INTERVALS = {'daily': 86400, 'hourly': 3600, 'minutely_15': 900}
+
+
+class Table(object):
+    """FlatBuffers table: {slot: (struct format, value)}, or (None, child) for a
+    reference to a Table, Vector or str."""
+
+    def __init__(self, fields):
+        self.fields = fields
+
+
+class Vector(object):
+    def __init__(self, fmt, items):
+        self.fmt = fmt  # Struct format of the elements, None for child references
+        self.items = items
+
+
+class FlatBuffer(object):
+    """Writes front to back: every object lands after whatever refers to it, so
+    each reference is a forward (unsigned) offset patched in once its target exists."""
+
+    def __init__(self):
+        self.data = bytearray()
+
+    def align(self, size):
+        self.data.extend(b'\0' * (-len(self.data) % size))
+
+    def reserve(self, size):
+        self.align(size)
+        self.data.extend(b'\0' * size)
+        return len(self.data) - size
+
+    def put(self, fmt, value):
+        pos = self.reserve(struct.calcsize(fmt))
+        struct.pack_into('<' + fmt, self.data, pos, value)
+        return pos
+
+    def child(self, ref, obj):
+        struct.pack_into('<I', self.data, ref, self.write(obj) - ref)
+
+    def write(self, obj):
+        if isinstance(obj, str):
+            encoded = obj.encode('utf-8')
+            pos = self.put('I', len(encoded))
+            self.data.extend(encoded + b'\0')
+            return pos
+        if isinstance(obj, Vector):
+            pos = self.put('I', len(obj.items))
+            refs = [self.put(obj.fmt or 'I', item if obj.fmt else 0) for item in obj.items]
+            if not obj.fmt:
+                for ref, item in zip(refs, obj.items):
+                    self.child(ref, item)
+            return pos
+
+        # Table: vtable, then the table (an int32 back to its vtable and the fields)
+        slots = max(obj.fields) + 1
+        self.align(2)
+        vtable = len(self.data)
+        self.data.extend(b'\0' * (4 + 2 * slots))
+        self.align(8)
+        table = self.put('i', 0)
+        struct.pack_into('<i', self.data, table, table - vtable)
+        refs = []
+        for slot in sorted(obj.fields):
+            fmt, value = obj.fields[slot]
+            pos = self.put(fmt or 'I', value if fmt else 0)
+            struct.pack_into('<H', self.data, vtable + 4 + 2 * slot, pos - table)
+            if not fmt:
+                refs.append((pos, value))
+        struct.pack_into('<HH', self.data, vtable, 4 + 2 * slots, len(self.data) - table)
+        for ref, value in refs:
+            self.child(ref, value)
+        return table
+
+
+def no_data(value):
+    """FlatBuffers float for a JSON value; missing data (null) is NaN."""
+    return float('nan') if value is None else float(value)
+
+
+def open_meteo_flatbuffer(response, query, utc_offset):
+    """Encode a JSON-shaped Open-Meteo response (local times at utc_offset seconds)
+    as its FlatBuffers equivalent."""
+    fields = {RESPONSE_UTC_OFFSET: ('i', utc_offset), RESPONSE_TIMEZONE: (None, time.strftime('%Z'))}
+    for name, slot in RESPONSE_SECTIONS.items():
+        if name not in response:
+            continue
+        section = response[name]
+        names = query.get(name, [''])[0].split(',')
+        if name == 'current':
+            variables = [Table({VARIABLE_VALUE: ('f', no_data(section.get(n)))}) for n in names]
+            fields[slot] = (None, Table({SECTION_VARIABLES: (None, Vector(None, variables))}))
+            continue
+        # Series run in Unix time; readers add utc_offset_seconds for local times
+        times = section['time']
+        first = datetime.strptime(times[0], '%Y-%m-%d' if name == 'daily' else '%Y-%m-%dT%H:%M')
+        start = int((first - datetime(1970, 1, 1)).total_seconds()) - utc_offset
+        interval = SECTION_INTERVALS[name]
+        variables = [Table({VARIABLE_VALUES: (None, Vector('f', [no_data(v) for v in
+                                                                  section.get(n, [None] * len(times))]))})
+                     for n in names]
+        fields[slot] = (None, Table({
+            SECTION_TIME: ('q', start),
+            SECTION_TIME_END: ('q', start + interval * len(times)),
+            SECTION_INTERVAL: ('i', interval),
+            SECTION_VARIABLES: (None, Vector(None, variables)),
+        }))
+
+    buffer = FlatBuffer()
+    buffer.reserve(8)  # Size prefix and root offset
+    buffer.child(4, Table(fields))
+    struct.pack_into('<I', buffer.data, 0, len(buffer.data) - 4)
+    return bytes(buffer.data)
+
+
+def tide_predictions(clock):
+    """NOAA hilo predictions: alternating highs and lows every ~6.2 hours."""
+    start = clock.now()
+    predictions = []
+    for i in range(8):
+        moment = start + timedelta(hours=i * 6.2 + 1)
+        high = i % 2 == 0
+        predictions.append({'t': moment.strftime('%Y-%m-%d %H:%M'), 'v': '5.412' if high else '0.873',
+                            'type': 'H' if high else 'L'})
+    return {'predictions': predictions}
+
+
+def stop_monitoring(clock, query):
+    """511 StopMonitoring: arrivals every 9 minutes on the requested stop."""
+    now = clock.utcnow()
+    visits = []
+    for i in range(1, 6):
+        visits.append({'MonitoredVehicleJourney': {
+            'LineRef': '38R', 'DirectionRef': 'IB',
+            'MonitoredCall': {'StopPointRef': query.get('stopCode', [''])[0],
+                              'ExpectedArrivalTime': (now + timedelta(minutes=9 * i - 4)).strftime(
+                                  '%Y-%m-%dT%H:%M:%SZ')},
+        }})
+    return {'ServiceDelivery': {'ResponseTimestamp': now.strftime('%Y-%m-%dT%H:%M:%SZ'),
+                                'StopMonitoringDelivery': {'MonitoredStopVisit': visits}}}
+
+
+def pollen(clock, query):
+    days = int(query.get('days', ['1'])[0])
+    info = [{'code': code, 'indexInfo': {'value': value}} for code, value in (('TREE', 3), ('GRASS', 1), ('WEED', 0))]
+    return {'dailyInfo': [{'pollenTypeInfo': info} for _ in range(days)]}
+
+
+def provider_response(clock, path, query):
+    """JSON body for a provider request path ("host/path"), or None for 404."""
+    if path == 'api.open-meteo.com/v1/forecast':
+        return forecast(clock, query)
+    if path == 'air-quality-api.open-meteo.com/v1/air-quality':
+        return {'current': {'time': iso(clock.now()), 'us_aqi': 42}}
+    if path == 'api.tidesandcurrents.noaa.gov/mdapi/prod/webapi/stations.json':
+        return {'stations': [{'id': '9414290', 'lat': 37.8063, 'lng': -122.4659},
+                             {'id': '9414750', 'lat': 37.7717, 'lng': -122.2983}]}
+    if path.endswith('/harcon.json'):
+        return {'HarmonicConstituents': [
+            {'name': 'M2', 'amplitude': 1.896, 'phase_GMT': 330.4, 'speed': 28.984104},
+            {'name': 'S2', 'amplitude': 0.441, 'phase_GMT': 333.4, 'speed': 30.0},
+            {'name': 'K1', 'amplitude': 1.217, 'phase_GMT': 105.9, 'speed': 15.041069},
+            {'name': 'O1', 'amplitude': 0.757, 'phase_GMT': 89.8, 'speed': 13.943035},
+        ]}
+    if path.endswith('/datums.json'):
+        return {'datums': [{'name': 'MSL', 'value': 3.18}, {'name': 'MLLW', 'value': 0.0}]}
+    if path == 'api.tidesandcurrents.noaa.gov/api/prod/datagetter':
+        return tide_predictions(clock)
+    if path == 'nominatim.openstreetmap.org/reverse':
+        return {'address': {'city': 'San Francisco'}}
+    if path == 'api.511.org/transit/StopMonitoring':
+        return stop_monitoring(clock, query)
+    if path == 'pollen.googleapis.com/v1/forecast:lookup':
+        return pollen(clock, query)
+    if path == 'benchmark/config':
+        config = dict(BASE_CONFIG)
+        config['INVERT'] = clock.now().hour in INVERTED_HOURS
+        return config
+    return None
+
+
+class Providers(ThreadingHTTPServer):
+    daemon_threads = True
+
+    def __init__(self, port, clock):
+        ThreadingHTTPServer.__init__(self, ('127.0.0.1', port), ProviderHandler)
+        self.clock = clock
+        self.lock = threading.Lock()
+        self.fetch_bytes = {}  # Simulated local hour -> bytes served
+        self.open_meteo_formats = {'flatbuffers': 0, 'json': 0}  # Open-Meteo requests per format
+
+
+class ProviderHandler(BaseHTTPRequestHandler):
+    def do_GET(self):
+        url = urlsplit(self.path)
+        query = parse_qs(url.query)
+        response = provider_response(self.server.clock, url.path.lstrip('/'), query)
+        if response is None:
+            self.send_error(404)
+            return
+        content_type = 'application/json'
+        if query.get('format') == ['flatbuffers']:
+            body = open_meteo_flatbuffer(response, query, self.server.clock.utc_offset())
+            content_type = 'application/octet-stream'
+        else:
+            body = json.dumps(response).encode('utf-8')
+        if 'open-meteo.com/' in url.path:
+            with self.server.lock:
+                self.server.open_meteo_formats['flatbuffers' if 'format' in query else 'json'] += 1
+
+        if not url.path.startswith('/benchmark/'):
+            hour = self.server.clock.hour_start(self.server.clock.now())
+            with self.server.lock:
+                self.server.fetch_bytes[hour] = self.server.fetch_bytes.get(hour, 0) + len(body)
+
+        self.send_response(200)
+        self.send_header('Content-Type', content_type)
+        self.send_header('Content-Length', str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+    def log_message(self, format, *args):
+        pass
+
+
+def pebble(args, **kwargs):
+    return subprocess.Popen(['pebble'] + args, cwd=REPO, **kwargs)
+
+
+def build(endpoint):
+    env = dict(os.environ, FITZFACE_BENCHMARK=endpoint)
+    subprocess.check_call(['pebble', 'build'], cwd=REPO, env=env)
+
+
+def run_timeline(clock, server, platform):
+    """Install under faketime and collect HOURS full hours of BENCH lines, one
+    row per simulated hour after the partial launch hour. An hour whose line
+    never arrived stays None so later hours keep their place."""
+    subprocess.call(['pebble', 'kill'], cwd=REPO)
+    emulator = subprocess.Popen(['faketime', '-f', '+0 x%g' % clock.rate, 'pebble', 'install',
+                                 '--emulator', platform, '--logs'],
+                                cwd=REPO, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                                universal_newlines=True)
+    clock.restart()
+
+    events = sorted([(start, False) for start, _ in DISCONNECTS] + [(end, True) for _, end in DISCONNECTS])
+
+    def script():
+        for at, connected in events:
+            delay = at * 3600.0 / clock.rate - (time.time() - clock.origin)
+            if delay > 0:
+                time.sleep(delay)
+            pebble(['emu-bt-connection', '--connected', 'yes' if connected else 'no']).wait()
+
+    threading.Thread(target=script, daemon=True).start()
+
+    # Read the log on a thread so a silent emulator can't outlast the deadline
+    lines = queue.Queue()
+
+    def read():
+        for line in emulator.stdout:
+            lines.put(line)
+        lines.put(None)
+
+    threading.Thread(target=read, daemon=True).start()
+
+    rows = [None] * HOURS
+    first_hour = clock.hour_start(clock.now()) + timedelta(hours=1)
+    deadline = clock.origin + (HOURS + 1.5) * 3600.0 / clock.rate
+    while rows[-1] is None:
+        try:
+            line = lines.get(timeout=max(0, deadline - time.time()))
+        except queue.Empty:
+            break
+        if line is None:
+            break
+        match = BENCH_LINE.search(line)
+        if not match:
+            continue
+        # The report comes just after the hour it covers ended
+        hour = clock.hour_start(clock.now() - timedelta(minutes=30))
+        index = int((hour - first_hour).total_seconds() // 3600)
+        if index < 0 or index >= HOURS:
+            continue  # The partial launch hour
+        row = dict((name, int(value)) for name, value in
+                   (pair.split('=') for pair in match.group(2).split()))
+        row['clock_hour'] = int(match.group(1))
+        if row['clock_hour'] != hour.hour:
+            print('warning: hour %d reported as %d:00 (clock drift?)' % (index, row['clock_hour']), file=sys.stderr)
+        with server.lock:
+            row['fetch_bytes'] = server.fetch_bytes.get(hour, 0)
+        rows[index] = row
+        print('hour %2d: %s fetch_bytes=%d' % (index, match.group(2).strip(), row['fetch_bytes']),
+              file=sys.stderr)
+    emulator.terminate()
+    subprocess.call(['pebble', 'kill'], cwd=REPO)
+    return rows
+
+
+def compare(rows, baseline, tolerance):
+    """Regressions against a baseline run: (hour, metric, baseline, current).
+    Hours missing from either run are skipped."""
+    regressions = []
+    for hour, (row, base) in enumerate(zip(rows, baseline['hours'])):
+        if row is None or base is None:
+            continue
+        for metric in GATED:
+            limit = base.get(metric, 0) * (1 + tolerance)
+            if row.get(metric, 0) > max(limit, base.get(metric, 0) + 1):
+                regressions.append((hour, metric, base.get(metric, 0), row.get(metric, 0)))
+    return regressions
+
+
+def open_meteo_format(formats):
+    """The Open-Meteo format a run measured: 'json' once the companion fell back."""
+    if not formats or not (formats.get('flatbuffers') or formats.get('json')):
+        return None
+    return 'json' if formats.get('json') else 'flatbuffers'
+
+
+def print_table(rows):
+    columns = ('in', 'in_bytes', 'out', 'out_bytes', 'persist', 'redraws', 'heap', 'fetch_bytes')
+    print('hour ' + ' '.join('%10s' % c for c in columns))
+    for hour, row in enumerate(rows):
+        if row is None:
+            print('%4d ' % hour + ' '.join('%10s' % '-' for c in columns))
+        else:
+            print('%4d ' % hour + ' '.join('%10d' % row.get(c, 0) for c in columns))
+    reported = [row for row in rows if row is not None]
+    totals = [sum(row.get(c, 0) for row in reported) for c in columns]
+    totals[columns.index('heap')] = max([row.get('heap', 0) for row in reported] or [0])
+    print('%4s ' % 'all' + ' '.join('%10d' % t for t in totals))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('--platform', default='diorite', help='emulator platform (default: diorite)')
+    parser.add_argument('--rate', type=float, default=60, help='simulated seconds per second (default: 60)')
+    parser.add_argument('--port', type=int, default=8642, help='provider stand-in port (default: 8642)')
+    parser.add_argument('-o', '--output', help='write the per-hour results as JSON')
+    parser.add_argument('--baseline', help='results JSON of a previous run to compare against')
+    parser.add_argument('--tolerance', type=float, default=0.1,
+                        help='allowed growth over the baseline per metric and hour (default: 0.1)')
+    parser.add_argument('--no-build', action='store_true', help='install the existing build')
+    args = parser.parse_args()
+
+    endpoint = 'http://localhost:%d' % args.port
+    if not args.no_build:
+        build(endpoint)
+
+    clock = Clock(args.rate)
+    server = Providers(args.port, clock)
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+    try:
+        rows = run_timeline(clock, server, args.platform)
+    finally:
+        server.shutdown()
+
+    print_table(rows)
+    missing = [hour for hour, row in enumerate(rows) if row is None]
+    if missing:
+        print('warning: no BENCH line for hours %s (not compared)' % ', '.join(str(h) for h in missing),
+              file=sys.stderr)
+
+    formats = dict(server.open_meteo_formats)
+    if formats['json']:
+        print('warning: the companion fell back to JSON for %d Open-Meteo requests' % formats['json'],
+              file=sys.stderr)
+
+    result = {'platform': args.platform, 'rate': args.rate, 'open_meteo_formats': formats, 'hours': rows}
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(result, f, indent=1)
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        # Fetch bytes and companion work depend on the format, so only like runs compare
+        if open_meteo_format(baseline.get('open_meteo_formats')) != open_meteo_format(formats):
+            print('error: baseline measured Open-Meteo as %s, this run as %s' % (
+                open_meteo_format(baseline.get('open_meteo_formats')), open_meteo_format(formats)), file=sys.stderr)
+            sys.exit(2)
+        regressions = compare(rows, baseline, args.tolerance)
+        for hour, metric, before, after in regressions:
+            print('regression: hour %d %s %d -> %d' % (hour, metric, before, after), file=sys.stderr)
+        if regressions:
+            sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
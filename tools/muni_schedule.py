@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+"""Build the MUNI schedule index used when real-time predictions are unavailable.
+
+Reads an SFMTA GTFS feed (e.g. from http://api.511.org/transit/datafeeds?operator_id=SF)
+and writes the scheduled arrival times of the configured stop/route/direction
+combinations in the compact layout schedule.js reads. Host the output somewhere
+the phone can reach and enter its URL under MUNI > Schedule Index URL.
+
+    tools/muni_schedule.py GTFS.zip 15553/38R/IB 13565/N/OB -o muni_schedule.json
+
+Routes use the same stop/route/direction notation as the MUNI settings. Stops
+match GTFS stop_code (the 511 stop code), falling back to stop_id.
+"""
+
+import argparse
+import csv
+import io
+import json
+import sys
+import zipfile
+
+INDEX_VERSION = 1
+WEEKDAYS = ('monday', 'tuesday', 'wednesday', 'thursday', 'friday', 'saturday', 'sunday')
+
+
+def read_table(feed, name):
+    try:
+        with feed.open(name) as f:
+            return list(csv.DictReader(io.TextIOWrapper(f, encoding='utf-8-sig')))
+    except KeyError:
+        return []
+
+
+def parse_minutes(value):
+    hours, minutes, _ = (int(part) for part in value.strip().split(':'))
+    return hours * 60 + minutes
+
+
+def parse_route(spec):
+    parts = [part.strip() for part in spec.split('/')]
+    if len(parts) < 2 or not parts[0] or not parts[1]:
+        raise argparse.ArgumentTypeError('expected stop/route[/direction]: %s' % spec)
+    direction = parts[2].upper() if len(parts) > 2 and parts[2] else 'IB'
+    return parts[0], parts[1].upper(), direction
+
+
+def build_index(feed, routes, inbound_direction):
+    stop_ids = {}
+    for stop in read_table(feed, 'stops.txt'):
+        stop_ids[stop['stop_id']] = stop.get('stop_code') or stop['stop_id']
+
+    route_names = {}
+    for route in read_table(feed, 'routes.txt'):
+        route_names[route['route_id']] = (route.get('route_short_name') or route['route_id']).upper()
+
+    wanted = set(routes)
+    trips = {}
+    for trip in read_table(feed, 'trips.txt'):
+        direction = 'IB' if trip.get('direction_id', '') == str(inbound_direction) else 'OB'
+        trips[trip['trip_id']] = (route_names.get(trip['route_id']), direction, trip['service_id'])
+
+    times = {}
+    for stop_time in read_table(feed, 'stop_times.txt'):
+        trip = trips.get(stop_time['trip_id'])
+        stop = stop_ids.get(stop_time['stop_id'])
+        if not trip or (stop, trip[0], trip[1]) not in wanted:
+            continue
+        arrival = stop_time.get('arrival_time') or stop_time.get('departure_time')
+        if not arrival:
+            continue
+        key = '%s/%s' % (trip[0], trip[1])
+        times.setdefault(stop, {}).setdefault(key, {}).setdefault(trip[2], []).append(parse_minutes(arrival))
+
+    services = {}
+    for calendar in read_table(feed, 'calendar.txt'):
+        services[calendar['service_id']] = {
+            'days': ''.join(calendar[day] for day in WEEKDAYS),
+            'start': int(calendar['start_date']),
+            'end': int(calendar['end_date']),
+        }
+    for exception in read_table(feed, 'calendar_dates.txt'):
+        service = services.setdefault(exception['service_id'],
+                                      {'days': '0000000', 'start': 0, 'end': 0})
+        kind = 'add' if exception['exception_type'] == '1' else 'remove'
+        service.setdefault(kind, []).append(int(exception['date']))
+
+    # Delta-encode each service's sorted minutes
+    used = set()
+    for by_route in times.values():
+        for by_service in by_route.values():
+            for service_id, minutes in by_service.items():
+                minutes.sort()
+                by_service[service_id] = [minutes[0]] + [b - a for a, b in zip(minutes, minutes[1:])]
+                used.add(service_id)
+
+    for stop, route, direction in routes:
+        if '%s/%s' % (route, direction) not in times.get(stop, {}):
+            print('warning: no scheduled arrivals for %s/%s/%s' % (stop, route, direction), file=sys.stderr)
+
+    return {
+        'v': INDEX_VERSION,
+        'services': {service_id: services[service_id] for service_id in sorted(used) if service_id in services},
+        'stops': times,
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('feed', help='GTFS zip file')
+    parser.add_argument('routes', nargs='+', type=parse_route, help='stop/route/direction, e.g. 15553/38R/IB')
+    parser.add_argument('-o', '--output', default='-', help='output file (default: stdout)')
+    parser.add_argument('--inbound-direction', type=int, default=1,
+                        help='GTFS direction_id of inbound trips (default: 1)')
+    args = parser.parse_args()
+
+    with zipfile.ZipFile(args.feed) as feed:
+        index = build_index(feed, args.routes, args.inbound_direction)
+
+    text = json.dumps(index, separators=(',', ':'))
+    if args.output == '-':
+        print(text)
+    else:
+        with open(args.output, 'w') as f:
+            f.write(text)
+        print('%s: %d bytes' % (args.output, len(text)), file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()